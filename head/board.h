@@ -1,43 +1,104 @@
-
 #ifndef _BOARD_H_
 #define _BOARD_H_
 
-#include <iostream>
-#include <iomanip>
 #include <vector>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
 
-namespace colors
-{
-	const std::string red = "\u001b[91m";
-	const std::string green = "\u001b[92m";
-	const std::string reset = "\u001b[0m";
-}
-
+// Dense boards keep one char per cell in a mailbox grid: the board is
+// surrounded by a border of BORDER cells, so line scans walk raw indices
+// with the precomputed direction offsets and simply stop at the border
+// instead of range-checking every step. The border is win_length cells
+// wide, just enough for the window scans in Evaluator and MinimaxAI, so
+// boards are built for the win length they are played with.
+// Sparse boards keep only the stones in a hash map, so memory and the
+// stone-driven scans (checkWin, getFrontier, the evaluator) cost O(stones)
+// instead of O(size^2); off-board cells read as BORDER there too.
+// A size of INFINITE_SIZE gives an unbounded sparse board; any coordinate,
+// including negative ones, is on it.
 class Board
 {
 private:
     std::vector<char> grid;
-    int index(int row, int col) const { return board_size * row + col; }
-	char empty = ' ';
+    std::unordered_map<long long, char> cells;
+    std::vector<std::pair<int, int>> stones;
+
+    int index(int row, int col) const { return (row + border) * stride + col + border; }
+    static long long key(int row, int col) { return (long long)(((unsigned long long)(unsigned int)row << 32) | (unsigned int)col); }
+
 	int board_size = 3;
+	char empty = ' ';
+	bool sparse = false;
+	int border = 0;
+	int stride = 0;
+	int offsets[4] = {0, 0, 0, 0};
+
+	// Zobrist-style position hash, kept up to date by place(). Cell keys are
+	// mixed from the coordinates instead of looked up, so infinite boards
+	// hash too, and the values are the same on every run.
+	unsigned long long hash = 0;
+	static unsigned long long cellHash(const int& row, const int& col, const char& mark);
+
+	int min_row = 0, max_row = -1, min_col = 0, max_col = -1;
+
+	mutable std::vector<unsigned int> seen;
+	mutable unsigned int seen_stamp = 0;
+
+	void addStone(const int& row, const int& col);
+	void removeStone(const int& row, const int& col);
+	void updateBounds();
 
 public:
+	static const int INFINITE_SIZE = 0;
+	static const int SPARSE_THRESHOLD = 32;
+	static constexpr char BORDER = '\0';
+	static constexpr int DIRECTIONS[4][2] = { {0, 1}, {1, 0}, {1, 1}, {1, -1} };
+
 	Board() {};
-	Board(const int& bsize);
-	Board(const int& bsize, const char& empty_symbol);
-	void print() const;
-	void print(const char& player1, const char& player2) const;
+	Board(const int& bsize, const int& wlength);
+	Board(const int& bsize, const char& empty_symbol, const int& wlength);
+	Board(const int& bsize, const char& empty_symbol, const bool& use_sparse, const int& wlength);
+	// Boards used to be built without a win length; a leftover
+	// Board(size, empty) would otherwise take the empty symbol for one.
+	Board(const int& bsize, const char& empty_symbol) = delete;
+
+	bool isInside(const int& row, const int& col) const;
 	bool isCellEmpty(const int& row,const int& col) const;
 
 	bool isFull() const;
-	char getEmpty() const { return empty; }	    
+	bool isInfinite() const { return board_size == INFINITE_SIZE; }
+	bool isSparse() const { return sparse; }
+	int getBorder() const { return border; }
+	char getEmpty() const { return empty; }
+	unsigned long long getHash() const { return hash; }
     int getSize() const;
+    std::pair<int, int> getCenter() const;
+
+    // Checked: throws GridError off the board. Use at input boundaries.
     void setCell(const int& y, const int& x, const char& mark);
-	const char& getCell(const int& y, const int& x) const;
-    const std::vector<char>& getGrid() const { return grid; }
+    // Unchecked, for the engine: the cell must be on the board.
+    void place(const int& y, const int& x, const char& mark);
+    // Off-board cells within the border read as BORDER.
+	char getCell(const int& y, const int& x) const;
+
+	int countRun(const int& row, const int& col, const int& direction, const int& step, const char& mark) const;
+	void countWindow(const int& row, const int& col, const int& direction, const int& length,
+	                 const char& first, const char& second, int& firstCount, int& secondCount, int& blocked) const;
+
+	// Raw mailbox access for batched kernels (dense boards only).
+	const char* getGrid() const { return grid.data(); }
+	int getGridSize() const { return (int)grid.size(); }
+	int getStride() const { return stride; }
+	int getOffset(const int& direction) const { return offsets[direction]; }
+	int indexOf(const int& row, const int& col) const { return index(row, col); }
+
+	const std::vector<std::pair<int, int>>& getStones() const { return stones; }
+	bool getBounds(int& top, int& left, int& bottom, int& right) const;
 	bool checkWin(const char& mark, const int& win_length) const;
     std::vector<std::pair<int, int>> getEmptyCells() const;
+    std::vector<std::pair<int, int>> getFrontier() const;
 };
 
 class GridError {};
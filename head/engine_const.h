@@ -1,6 +1,10 @@
 #ifndef _ENGINE_CONST_H_
 #define _ENGINE_CONST_H_
 
+#include <vector>
+#include <utility>
+#include <climits>
+
 namespace EngineConst
 {
     const int WIN_SCORE = 1000000;
@@ -8,6 +12,18 @@ namespace EngineConst
     
     const int INF = 1000000000;
     const int NEG_INF = -INF;
+
+    // Infinite boards accept negative coordinates, so "no move" can't be -1.
+    const std::pair<int, int> NO_MOVE = {INT_MIN, INT_MIN};
+
+    const int NULL_MOVE_REDUCTION = 2;
+    const int LMR_FULL_MOVES = 3;
+    const int LMR_MIN_DEPTH = 3;
+
+    const int THREAT_NONE = 0;
+    const int THREAT_OPEN_THREE = 1;
+    const int THREAT_FOUR = 2;
+    const int THREAT_WIN = 3;
     
     const std::vector<int> LINE_SCORES = {
         0,      
@@ -0,0 +1,46 @@
+#ifndef _EVALUATOR_H_
+#define _EVALUATOR_H_
+
+#include "board.h"
+#include "engine_const.h"
+#include "pattern.h"
+#include <utility>
+#include <vector>
+
+class Evaluator
+{
+private:
+    char aiMark;
+    char playerMark;
+    int win_length;
+    std::shared_ptr<const PatternTable> patterns;
+
+    // Scratch space for moveGains, one slot per mailbox cell.
+    mutable std::vector<unsigned char> aiCounts, playerCounts, blockedCounts;
+    mutable std::vector<int> aiDeltas, playerDeltas, aiSums, playerSums;
+
+public:
+    Evaluator() {};
+    Evaluator(const char& ai, const char& player, const int& wlength);
+
+    int evaluate(const Board& board) const;
+    int evaluatePosition(const Board& board) const;
+    int evaluateLine(const Board& board, std::pair<int, int> start, const int& direction) const;
+
+    // Batched kernel: how much evaluatePosition changes if each of cells
+    // gets an AI (aiGains) or a player (playerGains) stone, for all cells at
+    // once. A move that completes a line gains +-PatternTable::WIN_GAIN.
+    // Works on dense boards with at least one stone and no completed line;
+    // returns false, leaving the outputs alone, when it doesn't apply.
+    bool moveGains(const Board& board, const std::vector<std::pair<int, int>>& cells,
+                   std::vector<int>& aiGains, std::vector<int>& playerGains) const;
+    // evaluate() of the board after each of cells is played by the AI or by
+    // the player. Uses moveGains where it can and plays the moves out
+    // otherwise; the board is left as it was.
+    void scoreMoves(Board& board, const std::vector<std::pair<int, int>>& cells,
+                    std::vector<int>& aiScores, std::vector<int>& playerScores) const;
+
+    bool isTerminal(const Board& board) const;
+};
+
+#endif
@@ -2,7 +2,10 @@
 #ifndef GAME_H
 #define GAME_H
 #include "board.h"
+#include "renderer.h"
 #include "player.h"
+#include "record.h"
+#include "tracer.h"
 #include "cfig.h"
 #include "engine_const.h"
 
@@ -11,13 +14,16 @@ class Game
 {
 private:
 	Board board;
+	Renderer renderer;
+	GameRecorder recorder;
+	Tracer tracer;
 	Player* player1;
 	Player* player2;
 	Player* currentPlayer;
 	int win_length;
 	bool gameOver;
 	bool color;
-      bool clear_console;
+	bool clear_console = false;
 
     char aiMark;
     char playerMark;
@@ -35,12 +41,6 @@ public:
 	void handleInput();
 	bool isOver();
     void run();
-
-    int evaluate(const Board& board) const;
-    int evaluatePosition(const Board& board) const;
-    int evaluateLine(const Board& board, std::pair<int, int> start, std::pair<int, int> delta) const;
-
-    bool isTerminal(const Board& board) const;
 };
 
 #endif
@@ -4,14 +4,58 @@
 #include "cfig.h"
 #include "board.h"
 
+#include "evaluator.h"
 #include "engine_const.h"
+#include "tracer.h"
+#include "transposition.h"
 #include <vector>
 #include <string>
 #include <unordered_map>
-#include <ctime>
+#include <chrono>
 #include <algorithm>
+#include <atomic>
+#include <functional>
 
-class Game;
+struct SearchOptions
+{
+    bool lmr = false;
+    bool null_move = false;
+    bool extensions = false;
+    bool quiescence = false;
+    int quiescence_depth = 6;
+    int multi_pv = 1;
+};
+
+struct SearchLine
+{
+    std::pair<int, int> move;
+    int score;
+    std::vector<std::pair<int, int>> pv;
+};
+
+// Result of one completed iterative-deepening depth.
+struct SearchUpdate
+{
+    int depth;
+    std::pair<int, int> move;
+    int score;
+    long long nodes;
+};
+
+// Lets another thread stop a running search or move its deadline. The
+// deadline is a steady_clock time in nanoseconds; 0 keeps time_limit.
+struct SearchControl
+{
+    std::atomic<bool> stop{false};
+    std::atomic<long long> deadline{0};
+};
+
+struct MoveAnalysis
+{
+    std::pair<int, int> best;
+    int bestScore;
+    int playedScore;
+};
 
 class MinimaxAI
 {
@@ -20,35 +64,92 @@ private:
     char aiMark;       
     int max_depth;     
     int time_limit;    
+    long long node_limit = 0;
     int win_length;    
-    clock_t startTime; 
+    std::chrono::steady_clock::time_point startTime;
     bool showThinking; 
 
     std::vector<std::string> thinkingLog;
 
-    Game* game;   
+    Evaluator evaluator;
+    SearchOptions options;
+    TranspositionTable table;
+    static const unsigned long long SIDE_KEY = 0x9E3779B97F4A7C15ULL;
+    Tracer* tracer = nullptr;
+    const SearchControl* control = nullptr;
+    std::function<void(const SearchUpdate&)> onDepth;
+
+    long long nodes = 0;
+    long long qnodes = 0;
+    int reached_depth = 0;
+    std::vector<int> depthScores;
+    std::vector<SearchLine> lines;
+
+    // Triangular PV table: pvTable[ply] is the best line found from ply on.
+    bool trackPV = false;
+    std::vector<std::vector<std::pair<int, int>>> pvTable;
     
-    bool timeUp() const;
+    // Time limit and node budget; 0 turns either off. With both off the
+    // search always runs to max_depth, and with no time limit it is
+    // deterministic: same position and settings give the same move and
+    // node count on every run.
+    bool outOfBudget() const;
     
     void setMove(Board& board, int row, int col, char mark);
     void undoMove(Board& board, int row, int col);
     
-    int minimax(Board& board, int depth, int alpha, int beta, bool maximizingPlayer);
+    int minimax(Board& board, int depth, int alpha, int beta, bool maximizingPlayer,
+                int ply = 0, bool nullAllowed = true);
     
-    std::pair<int, int> iterativeDeepening(Board& board);
+    int quiescence(Board& board, int alpha, int beta, bool maximizingPlayer, int qdepth);
+    int searchLeaves(Board& board, int alpha, int beta, bool maximizingPlayer, int ply, std::pair<int, int>& bestMove);
+    void storeEntry(unsigned long long key, int depth, int best, std::pair<int, int> bestMove, int alphaOrig, int betaOrig);
+
+    int searchRoot(Board& board, int depth, int count, std::vector<SearchLine>& result);
+    std::pair<int, int> iterativeDeepening(Board& board, int count);
     
+    std::vector<std::pair<int, int>> getCandidateMoves(const Board& board) const;
     std::vector<std::pair<int, int>> getOrderedMoves(const Board& board, bool forAI) const;
     
     int quickMoveScore(const Board& board, int row, int col, char mark, bool forAI) const;
     
     bool isWinningMove(const Board& board, int row, int col, char mark) const;
+    void checkBorder(const Board& board) const;
+
+    bool completesLine(const Board& board, int row, int col, char mark) const;
+    int threatLevel(const Board& board, int row, int col, char mark) const;
+    bool hasWinningReply(const Board& board, const std::vector<std::pair<int, int>>& moves, char mark) const;
+    bool hasOpenThree(const Board& board, char mark) const;
 public:
     
     MinimaxAI() {};
-    MinimaxAI(const Cfig& cfig, Game* game = nullptr);
-    ~MinimaxAI();
+    // Plays ai against opponent with the settings of [AI], overridden by
+    // the same keys in section (the player's own section).
+    MinimaxAI(const Cfig& cfig, const char& ai, const char& opponent, const std::string& section);
+    // The same for a board whose win length isn't [game] win_length.
+    MinimaxAI(const Cfig& cfig, const char& ai, const char& opponent, const std::string& section, const int& wlength);
+    MinimaxAI(const char& ai, const char& player, const int& wlength, const int& depth, const int& tlimit);
 
     std::pair<int, int> findBestMove(Board& board);
+    // Top count root moves, best first, with exact scores and principal
+    // variations, from one search.
+    std::vector<SearchLine> findBestMoves(Board& board, int count);
+    MoveAnalysis analyseMove(Board& board, int row, int col, int depth);
+    void setTimeLimit(const int& tlimit) { time_limit = tlimit; }
+    void setNodeLimit(const long long& limit) { node_limit = limit; }
+    void setOptions(const SearchOptions& opts) { options = opts; }
+    const SearchOptions& getOptions() const { return options; }
+    void setTracer(Tracer* t) { tracer = t; }
+    // A size of 0 or less turns the table off.
+    void setTableSize(const int& size_mb) { table = TranspositionTable(std::max(0, size_mb)); }
+    void clearTable() { table.clear(); }
+    void setControl(const SearchControl* c) { control = c; }
+    void setDepthCallback(const std::function<void(const SearchUpdate&)>& callback) { onDepth = callback; }
+    long long getNodeCount() const { return nodes; }
+    long long getQuiescenceNodeCount() const { return qnodes; }
+    int getReachedDepth() const { return reached_depth; }
+    const std::vector<int>& getDepthScores() const { return depthScores; }
+    const std::vector<SearchLine>& getLines() const { return lines; }
     const std::vector<std::string>& getThinkingLog() const { return thinkingLog; }
     void clearThinkingLog() { thinkingLog.clear(); }
 };
@@ -0,0 +1,150 @@
+#ifndef _PACKED_H_
+#define _PACKED_H_
+
+#include "board.h"
+#include <string>
+#include <fstream>
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+
+// Position packed at two bits per cell (EMPTY, FIRST or SECOND), row by row
+// with the board's own width, in a fixed block of 64-bit words: 104 bytes,
+// enough for boards up to MAX_SIZE x MAX_SIZE. The size and the marks are
+// not stored; positions that are compared or stored together share them,
+// like the records of one position file. Plain bytes with no pointers, so
+// it can be copied, hashed and compared as a whole and mapped from a file.
+class PackedPosition
+{
+public:
+    static const int MAX_SIZE = 20;
+    static const int CELLS_PER_WORD = 32;
+    static const int WORDS = (MAX_SIZE * MAX_SIZE + CELLS_PER_WORD - 1) / CELLS_PER_WORD;
+    enum Cell { EMPTY, FIRST, SECOND };
+
+private:
+    uint64_t words[WORDS] = {};
+
+public:
+    PackedPosition() {};
+    // Throws GridError for sparse boards, boards over MAX_SIZE and marks
+    // other than first and second.
+    PackedPosition(const Board& board, const char& first, const char& second);
+
+    Board toBoard(const int& size, const int& wlength, const char& first, const char& second, const char& empty) const;
+
+    int get(const int& index) const
+    {
+        return (words[index / CELLS_PER_WORD] >> (index % CELLS_PER_WORD * 2)) & 3;
+    }
+    void set(const int& index, const int& cell)
+    {
+        uint64_t& word = words[index / CELLS_PER_WORD];
+        int shift = index % CELLS_PER_WORD * 2;
+        word = (word & ~(3ULL << shift)) | ((uint64_t)cell << shift);
+    }
+    int countStones() const;
+
+    uint64_t hash() const;
+    bool operator==(const PackedPosition& other) const;
+    bool operator!=(const PackedPosition& other) const { return !(*this == other); }
+};
+
+namespace std
+{
+    template <>
+    struct hash<PackedPosition>
+    {
+        size_t operator()(const PackedPosition& position) const { return position.hash(); }
+    };
+}
+
+// Labelled position file, fixed stride so it can be memory mapped:
+//   PositionFileHeader, then PositionRecord after PositionRecord
+// Fields are in native byte order (little-endian on every machine we build
+// for). A record cut short at the end of the file (the writer died) is
+// ignored by readers.
+namespace PositionFormat
+{
+    const char MAGIC[3] = { 'T', 'T', 'P' };
+    const uint8_t VERSION = 1;
+}
+
+struct PositionFileHeader
+{
+    char magic[3];
+    uint8_t version;
+    uint8_t size;
+    uint8_t win_length;
+    char first;
+    char second;
+    uint32_t record_size;
+    uint32_t reserved;
+};
+
+struct PositionLabel
+{
+    int32_t score = 0;   // evaluation from the first mark's side
+    int16_t move = -1;   // row * size + col of the move played or -1
+    int8_t result = 0;   // 1 if first won the game, -1 if second did, 0 otherwise
+    uint8_t reserved = 0;
+};
+
+struct PositionRecord
+{
+    PackedPosition position;
+    PositionLabel label;
+};
+
+static_assert(sizeof(PositionFileHeader) == 16, "position file header must stay 16 bytes");
+static_assert(sizeof(PositionRecord) == 112, "position records must stay 112 bytes");
+static_assert(std::is_trivially_copyable<PositionRecord>::value, "position records are mapped from files");
+
+class PositionWriter
+{
+private:
+    std::ofstream out;
+    PositionFileHeader header;
+
+public:
+    // Appends to an existing file if its header matches, otherwise starts
+    // a new one; with append false it always starts a new one. Throws
+    // PositionFileError when appending to a mismatching file.
+    PositionWriter(const std::string& path, const int& size, const int& wlength, const char& first, const char& second,
+                   const bool& append = true);
+
+    bool isOpen() const { return out.is_open(); }
+    void write(const PackedPosition& position, const PositionLabel& label);
+    void flush() { out.flush(); }
+};
+
+// Read-only memory mapping of a position file (mmap, or MapViewOfFile on
+// Windows). Throws PositionFileError if the file can't be mapped or has no
+// valid header.
+class PositionFile
+{
+private:
+    void* data = nullptr;
+    size_t bytes = 0;
+    size_t count = 0;
+
+public:
+    PositionFile(const std::string& path);
+    ~PositionFile();
+    PositionFile(const PositionFile&) = delete;
+    PositionFile& operator=(const PositionFile&) = delete;
+
+    const PositionFileHeader& getHeader() const { return *static_cast<const PositionFileHeader*>(data); }
+    size_t size() const { return count; }
+    const PositionRecord* begin() const
+    {
+        return reinterpret_cast<const PositionRecord*>(static_cast<const char*>(data) + sizeof(PositionFileHeader));
+    }
+    const PositionRecord* end() const { return begin() + count; }
+    const PositionRecord& operator[](const size_t& index) const { return begin()[index]; }
+};
+
+class PositionFileError {};
+
+#endif
@@ -0,0 +1,40 @@
+#ifndef _PATTERN_H_
+#define _PATTERN_H_
+
+#include <vector>
+#include <memory>
+
+// Score of one win_length window by how many stones of each side it holds,
+// from the first side's point of view. Tables are immutable once built and
+// shared between all evaluators with the same win_length.
+class PatternTable
+{
+private:
+    int win_length;
+    std::vector<int> scores;
+    std::vector<int> firstGains;
+    std::vector<int> secondGains;
+
+    PatternTable(const int& wlength);
+
+public:
+    static std::shared_ptr<const PatternTable> get(const int& wlength);
+
+    // Completing a line gains WIN_GAIN, far above anything the windows
+    // around a single cell can add up to.
+    static const int WIN_GAIN = 4000000;
+
+    int score(const int& firstCount, const int& secondCount) const
+    {
+        return scores[firstCount * (win_length + 1) + secondCount];
+    }
+
+    // Change of a window's score when one more stone of a side goes into
+    // it, indexed by firstCount * (win_length + 1) + secondCount. The extra
+    // last slot, blockedIndex(), is zero for windows that hit the border.
+    const int* getFirstGains() const { return firstGains.data(); }
+    const int* getSecondGains() const { return secondGains.data(); }
+    int blockedIndex() const { return (win_length + 1) * (win_length + 1); }
+};
+
+#endif
@@ -4,16 +4,16 @@
 #include "board.h"
 #include <string>
 #include <iostream>
+#include <ctime>
 #include "minimax.h"
 #include "cfig.h"
 
-class Game;
-
 class Player
 {
 protected:
 	char mark;
 	std::string name;
+	std::pair<int, int> lastMove = EngineConst::NO_MOVE;
 
 public:
 	Player(const char& c, const std::string& m);
@@ -22,6 +22,7 @@ public:
 	virtual bool makeMove(Board& board) = 0;
 	char getMark() const { return mark; }
 	std::string getName() const { return name; }
+	std::pair<int, int> getLastMove() const { return lastMove; }
 };
 
 class Human : public Player
@@ -35,14 +36,17 @@ class AI : public Player
 {
 private:
 	MinimaxAI aiEngine;
-    int sleep_time;
+    int sleep_time = 0;
     std::vector<std::string> lastThinkingLog;
     void sleep(int milliseconds);
 public:
-	AI(const char& c, const std::string& n, const Cfig& cfig, Game* game = nullptr);
+	AI(const char& c, const char& opponent, const std::string& n, const Cfig& cfig, const std::string& section);
 	bool makeMove(Board& board) override;
     void printThinkingLog();
+    // Terminal lines printThinkingLog writes.
+    int getThinkingLogLines() const { return lastThinkingLog.empty() ? 0 : (int)lastThinkingLog.size() + 4; }
     void clearLastLog() { lastThinkingLog.clear(); }
+    void setTracer(Tracer* tracer) { aiEngine.setTracer(tracer); }
 };
 
 #endif
@@ -0,0 +1,33 @@
+#ifndef _POOL_H_
+#define _POOL_H_
+
+#include <deque>
+#include <vector>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+class WorkerPool
+{
+private:
+    std::vector<std::thread> workers;
+    std::deque<std::function<void()>> queue;
+    size_t max_queue;
+    std::mutex mutex;
+    std::condition_variable ready;
+    std::condition_variable space;
+    bool stopping = false;
+
+    void work();
+
+public:
+    WorkerPool(const int& threads, const int& queue_size);
+    ~WorkerPool();
+
+    bool submit(std::function<void()> task);
+    void push(std::function<void()> task);
+    size_t pending();
+};
+
+#endif
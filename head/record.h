@@ -0,0 +1,74 @@
+#ifndef _RECORD_H_
+#define _RECORD_H_
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <cstdint>
+
+// Binary game record. A file is a plain concatenation of records:
+//   "TTR" version  varint size  varint win_length  first second empty
+//   varint (row * size + col + 1) per move, in play order
+//   varint 0 at the end of the game
+// Infinite boards (size 0) store each move as two zigzag varints instead,
+// (zigzag(row) + 1, zigzag(col)), so negative coordinates fit as well.
+// Marks are single bytes; the first mark moves first and players alternate.
+// A game cut short (the process died) ends at end of file, or at the zero
+// the next writer puts in front of its first header; readers skip zeros
+// between records.
+namespace RecordFormat
+{
+    const char MAGIC[3] = { 'T', 'T', 'R' };
+    const uint8_t VERSION = 1;
+}
+
+struct GameRecord
+{
+    int size = 0;
+    int win_length = 0;
+    char first = 'X';
+    char second = 'O';
+    char empty = ' ';
+    std::vector<std::pair<int, int>> moves;
+
+    char markAt(const size_t& ply) const { return ply % 2 == 0 ? first : second; }
+};
+
+class GameRecorder
+{
+private:
+    std::ofstream out;
+    int size = 0;
+    bool resumed = false;
+
+    void writeVarint(uint32_t value);
+    static uint32_t zigzag(const int& value) { return ((uint32_t)value << 1) ^ (uint32_t)(value >> 31); }
+
+public:
+    GameRecorder() {};
+    GameRecorder(const std::string& path);
+
+    bool isOpen() const { return out.is_open(); }
+    void begin(const int& bsize, const int& wlength, const char& first, const char& second, const char& empty);
+    void addMove(const int& row, const int& col);
+    void end();
+};
+
+class GameRecordReader
+{
+private:
+    std::ifstream in;
+
+    bool readVarint(uint32_t& value);
+    static int unzigzag(const uint32_t& value) { return (int)(value >> 1) ^ -(int)(value & 1); }
+
+public:
+    GameRecordReader(const std::string& path);
+
+    bool isOpen() const { return in.is_open(); }
+    bool next(GameRecord& record);
+};
+
+class RecordError {};
+
+#endif
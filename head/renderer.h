@@ -0,0 +1,53 @@
+#ifndef _RENDERER_H_
+#define _RENDERER_H_
+
+#include "board.h"
+#include <string>
+#include <vector>
+
+namespace colors
+{
+	const std::string red = "\u001b[91m";
+	const std::string green = "\u001b[92m";
+	const std::string reset = "\u001b[0m";
+}
+
+class Renderer
+{
+private:
+    std::string frame;
+    std::vector<char> shown;
+
+    // Visible part of the board: the whole board when it is bounded,
+    // the stones plus a margin when it is infinite.
+    int top = 0, left = 0, rows = 0, cols = 0;
+    int label_width = 2;
+
+    bool tty = false;
+    bool color = false;
+    bool redraw = false;
+    // Diff updates address absolute terminal lines: they are only right
+    // while nothing printed since the last frame has scrolled the screen.
+    bool anchored = false;
+    char player1 = 'X';
+    char player2 = 'O';
+
+    bool updateView(const Board& board);
+    void appendNumber(int value, int width);
+    void appendCell(const char& cell);
+    void moveTo(int line, int column);
+    void fullFrame(const Board& board);
+    void diffFrame(const Board& board);
+    void flush();
+    static int terminalHeight();
+
+public:
+    Renderer() {};
+    Renderer(const bool& use_color, const bool& in_place, const char& p1, const char& p2);
+
+    // below: how many lines the caller prints under the board before the
+    // next draw.
+    void draw(const Board& board, const int& below = 0);
+};
+
+#endif
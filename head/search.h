@@ -0,0 +1,56 @@
+#ifndef _SEARCH_H_
+#define _SEARCH_H_
+
+#include "board.h"
+#include "minimax.h"
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <exception>
+
+// Anytime search on its own thread. The handle copies the engine and the
+// board, so any number of handles can run at once without sharing mutable
+// state (the copy drops the engine's tracer). After each completed depth
+// the best move so far is passed to the callback, on the search thread,
+// and kept for getLatest(). stop() and setDeadline() may be called from
+// any thread; the search then returns the best move of the last completed
+// depth. The destructor stops the search and waits for it.
+class SearchHandle
+{
+private:
+    MinimaxAI engine;
+    Board board;
+    SearchControl control;
+    std::function<void(const SearchUpdate&)> callback;
+
+    mutable std::mutex mutex;
+    std::condition_variable finished;
+    SearchUpdate latest;
+    bool hasLatest = false;
+    bool done = false;
+    std::pair<int, int> result = EngineConst::NO_MOVE;
+    std::exception_ptr error;
+
+    std::thread worker;
+
+    void run();
+
+public:
+    SearchHandle(const MinimaxAI& ai, const Board& position,
+                 const std::function<void(const SearchUpdate&)>& onDepth = nullptr);
+    ~SearchHandle();
+    SearchHandle(const SearchHandle&) = delete;
+    SearchHandle& operator=(const SearchHandle&) = delete;
+
+    void stop();
+    void setDeadline(const int& milliseconds);
+
+    bool isDone() const;
+    bool getLatest(SearchUpdate& update) const;
+    // Blocks until the search ends; rethrows what the search threw.
+    std::pair<int, int> wait();
+};
+
+#endif
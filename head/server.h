@@ -0,0 +1,72 @@
+#ifndef _SERVER_H_
+#define _SERVER_H_
+
+#include "board.h"
+#include "minimax.h"
+#include "cfig.h"
+#include "pool.h"
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+
+struct Session
+{
+    Board board;
+    MinimaxAI engine;
+    char aiMark;
+    char playerMark;
+    int win_length;
+    std::mutex mutex;
+};
+
+struct Connection
+{
+    int fd;
+    std::mutex writeMutex;
+
+    Connection(const int& descriptor) : fd(descriptor) {}
+
+    void send(const std::string& line);
+};
+
+// POSIX only (Unix sockets): implemented in tools/engine_server.cpp and
+// built with tools/server.cpp, never into the game.
+class EngineServer
+{
+private:
+    std::string socket_path;
+    int max_depth;
+    int max_sessions;
+
+    WorkerPool pool;
+
+    std::unordered_map<int, std::shared_ptr<Session>> sessions;
+    std::mutex sessionsMutex;
+    int next_id = 1;
+
+    std::atomic<long long> served{0};
+    std::atomic<long long> rejected{0};
+    std::atomic<long long> expired{0};
+
+    std::shared_ptr<Session> findSession(const int& id);
+    std::string handleLine(const std::shared_ptr<Connection>& conn, const std::string& line);
+    void serve(std::shared_ptr<Connection> conn);
+    // Searches board, the session's position when the request came in, so
+    // a MOVE pipelined behind BEST or HINT doesn't change what is searched.
+    void search(std::shared_ptr<Connection> conn, int id, std::shared_ptr<Session> session, Board board,
+                std::chrono::steady_clock::time_point deadline, int count);
+
+public:
+    EngineServer(const Cfig& config);
+    void run();
+};
+
+class ServerError {};
+
+#endif
@@ -0,0 +1,145 @@
+#ifndef _TRACER_H_
+#define _TRACER_H_
+
+#include <string>
+#include <vector>
+#include <chrono>
+#include <iosfwd>
+
+// Search timeline for Perfetto (Chrome trace-event JSON) or speedscope and
+// flamegraph.pl (folded stacks). Spans are recorded for every findBestMove,
+// iterative-deepening depth and root move. Hot functions are too frequent
+// for a span per call, so their time is summed per enclosing span instead
+// (self time: checkWin inside evaluate is not counted twice) and written as
+// children packed into the gaps between that span's own children.
+//
+// Tracing is off unless a Tracer is installed on the current thread with
+// Tracer::Scope; TraceSpan and TraceTimer then cost one thread-local load
+// and a branch. A Tracer must only be used by one thread at a time.
+class Tracer
+{
+public:
+    enum Format { CHROME, FOLDED };
+    enum Counter { ORDERING, EVALUATE, CHECK_WIN, COUNTERS };
+
+    static inline thread_local Tracer* active = nullptr;
+
+    class Scope
+    {
+    private:
+        Tracer* previous;
+
+    public:
+        Scope(Tracer* tracer) : previous(active) { active = tracer; }
+        ~Scope() { active = previous; }
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    };
+
+private:
+    struct Event
+    {
+        std::string name;
+        std::string path;
+        long long start;
+        long long duration;
+        int depth;
+        long long calls;
+    };
+
+    struct Open
+    {
+        std::string name;
+        std::string path;
+        long long start;
+        size_t firstChild;
+        long long self[COUNTERS];
+        long long calls[COUNTERS];
+    };
+
+    struct Running
+    {
+        int counter;
+        long long start;
+        long long children;
+    };
+
+    std::string path;
+    Format format = CHROME;
+    std::chrono::steady_clock::time_point origin;
+    std::vector<Event> events;
+    std::vector<Open> open;
+    std::vector<Running> timers;
+
+    long long now() const;
+    void packCounters(const Open& span, long long end);
+    bool saveChrome(std::ostream& out) const;
+    bool saveFolded(std::ostream& out) const;
+
+public:
+    static const char* const COUNTER_NAMES[COUNTERS];
+
+    Tracer() {};
+    Tracer(const std::string& file, const Format& fmt);
+
+    bool isEnabled() const { return !path.empty(); }
+
+    void begin(const std::string& name);
+    void end();
+    void startTimer(const int& counter);
+    void stopTimer();
+
+    bool save() const;
+};
+
+class TraceSpan
+{
+private:
+    Tracer* tracer;
+
+public:
+    TraceSpan(const char* name) : tracer(Tracer::active)
+    {
+        if (tracer)
+            tracer->begin(name);
+    }
+    TraceSpan(const char* name, const int& value) : tracer(Tracer::active)
+    {
+        if (tracer)
+            tracer->begin(std::string(name) + " " + std::to_string(value));
+    }
+    TraceSpan(const char* name, const int& row, const int& col) : tracer(Tracer::active)
+    {
+        if (tracer)
+            tracer->begin(std::string(name) + " " + std::to_string(row) + "," + std::to_string(col));
+    }
+    ~TraceSpan()
+    {
+        if (tracer)
+            tracer->end();
+    }
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+};
+
+class TraceTimer
+{
+private:
+    Tracer* tracer;
+
+public:
+    TraceTimer(const Tracer::Counter& counter) : tracer(Tracer::active)
+    {
+        if (tracer)
+            tracer->startTimer(counter);
+    }
+    ~TraceTimer()
+    {
+        if (tracer)
+            tracer->stopTimer();
+    }
+    TraceTimer(const TraceTimer&) = delete;
+    TraceTimer& operator=(const TraceTimer&) = delete;
+};
+
+#endif
@@ -0,0 +1,42 @@
+#ifndef _TRANSPOSITION_H_
+#define _TRANSPOSITION_H_
+
+#include <vector>
+#include <utility>
+#include <cstddef>
+
+struct TableEntry
+{
+    unsigned long long key = 0;
+    int score = 0;
+    short depth = -1;
+    char bound = 0;
+    std::pair<int, int> move;
+};
+
+// Fixed-size transposition table, allocated once when it is sized. Each
+// engine owns its own, so memory is size_mb per engine and searches never
+// share entries. A slot keeps the latest position that maps to it unless
+// it already holds the same position at a greater depth.
+class TranspositionTable
+{
+private:
+    std::vector<TableEntry> entries;
+    size_t mask = 0;
+
+public:
+    enum Bound { NONE, EXACT, LOWER, UPPER };
+
+    TranspositionTable() {};
+    TranspositionTable(const size_t& size_mb);
+
+    bool isEnabled() const { return !entries.empty(); }
+    size_t getBytes() const { return entries.size() * sizeof(TableEntry); }
+
+    const TableEntry* probe(const unsigned long long& key) const;
+    void store(const unsigned long long& key, const int& depth, const int& score, const int& bound,
+               const std::pair<int, int>& move);
+    void clear();
+};
+
+#endif
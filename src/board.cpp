@@ -1,163 +1,287 @@
-
 #include "../head/board.h"
+#include "../head/tracer.h"
+
+#include <algorithm>
+
+Board::Board(const int& bsize, const int& wlength) : Board(bsize, ' ', wlength) {}
+
+Board::Board(const int& bsize, const char& empty_symbol, const int& wlength)
+	: Board(bsize, empty_symbol, bsize == INFINITE_SIZE || bsize > SPARSE_THRESHOLD, wlength) {}
 
-Board::Board(const int& bsize) : board_size(bsize)
+Board::Board(const int& bsize, const char& empty_symbol, const bool& use_sparse, const int& wlength)
+	: board_size(bsize), empty(empty_symbol), sparse(use_sparse || bsize == INFINITE_SIZE)
 {
-	grid.resize(board_size * board_size, empty);
-    
-        
+	if (board_size < 0 || wlength < 1 || empty == BORDER)
+		throw GridError();
+	if (sparse)
+		return;
+
+	border = wlength;
+	stride = board_size + 2 * border;
+	for (int d = 0; d < 4; d++)
+		offsets[d] = DIRECTIONS[d][0] * stride + DIRECTIONS[d][1];
+
+	grid.assign(stride * stride, BORDER);
+	for (int i = 0; i < board_size; i++)
+		std::fill(grid.begin() + index(i, 0), grid.begin() + index(i, board_size), empty);
 }
 
-Board::Board(const int& bsize, const char& empty_symbol) : board_size(bsize), empty(empty_symbol)
+bool Board::isInside(const int& row, const int& col) const
 {
-	
-	grid.resize(board_size * board_size, empty);
-    
-        
+	return isInfinite() || (row >= 0 && row < board_size && col >= 0 && col < board_size);
 }
 
-void Board::print(const char& player1, const char& player2) const
+bool Board::isCellEmpty(const int& row,const int& col) const
 {
-
-	
-	    
-    std::cout << std::endl << "   ";
-    for (int i = 0; i < board_size; i++) {
-        std::cout << std::setw(2) << i << " ";
-    }
-    std::cout << std::endl << "   ";
-    for (int i = 0; i < board_size * 3; i++) {
-        std::cout << "_";
-    }
-    std::cout << std::endl;
-    
-    for (int i = 0; i < board_size; i++) {
-        std::cout << std::setw(2) << i << "| ";
-        for (int j = 0; j < board_size; j++)
-        {
-        	if (grid[index(i, j)] == player1)
-        		std::cout << colors::green << grid[index(i, j)];
-        	else if (grid[index(i, j)] == player2)
-        		std::cout << colors::red << grid[index(i, j)];
-        	else
-        		std::cout << grid[index(i, j)];
-
-        	std::cout << colors::reset << "  ";
-        }
-        std::cout << std::endl;
-    }
-    std::cout << std::endl;
+	return isInside(row, col) && getCell(row, col) == empty;
 }
 
-void Board::print() const
+bool Board::isFull() const
 {
-
-	
-	    
-    std::cout << std::endl << "   ";
-    for (int i = 0; i < board_size; i++) {
-        std::cout << std::setw(2) << i << " ";
-    }
-    std::cout << std::endl << "   ";
-    for (int i = 0; i < board_size * 3; i++) {
-        std::cout << "_";
-    }
-    std::cout << std::endl;
-    
-    for (int i = 0; i < board_size; i++) {
-        std::cout << std::setw(2) << i << "| ";
-        for (int j = 0; j < board_size; j++)
-        	std::cout << grid[index(i, j)] << "  ";        	
-        std::cout << std::endl;
-    }
-    std::cout << std::endl;
+	return !isInfinite() && (long long)stones.size() == (long long)board_size * board_size;
 }
 
+int Board::getSize() const
+{
+	return board_size;
+}
 
+std::pair<int, int> Board::getCenter() const
+{
+	return {board_size / 2, board_size / 2};
+}
 
+unsigned long long Board::cellHash(const int& row, const int& col, const char& mark)
+{
+	// splitmix64 finalizer over (row, col, mark).
+	unsigned long long z = ((unsigned long long)(unsigned int)row << 32 | (unsigned int)col) * 0x9E3779B97F4A7C15ULL
+	                       + (unsigned char)mark;
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+	return z ^ (z >> 31);
+}
 
+void Board::addStone(const int& row, const int& col)
+{
+	stones.emplace_back(row, col);
+	if (stones.size() == 1)
+	{
+		min_row = max_row = row;
+		min_col = max_col = col;
+		return;
+	}
+	min_row = std::min(min_row, row);
+	max_row = std::max(max_row, row);
+	min_col = std::min(min_col, col);
+	max_col = std::max(max_col, col);
+}
 
+void Board::removeStone(const int& row, const int& col)
+{
+	// Search takes stones back in reverse order, so the match is almost
+	// always the last element.
+	for (size_t i = stones.size(); i-- > 0;)
+		if (stones[i].first == row && stones[i].second == col)
+		{
+			stones.erase(stones.begin() + i);
+			break;
+		}
 
+	if (row == min_row || row == max_row || col == min_col || col == max_col)
+		updateBounds();
+}
 
-bool Board::isCellEmpty(const int& row,const int& col) const 
+void Board::updateBounds()
 {
-	return row >= 0 && row < board_size && col >= 0 && col < board_size && grid[index(row, col)] == empty;
+	min_row = min_col = 0;
+	max_row = max_col = -1;
+	for (size_t i = 0; i < stones.size(); i++)
+	{
+		int row = stones[i].first, col = stones[i].second;
+		if (i == 0)
+		{
+			min_row = max_row = row;
+			min_col = max_col = col;
+			continue;
+		}
+		min_row = std::min(min_row, row);
+		max_row = std::max(max_row, row);
+		min_col = std::min(min_col, col);
+		max_col = std::max(max_col, col);
+	}
 }
 
-bool Board::isFull() const
+bool Board::getBounds(int& top, int& left, int& bottom, int& right) const
 {
-    for (const auto& cell : grid)
-        if (cell == empty) return false;
-	
-	
-	
-	
+	if (stones.empty())
+		return false;
+	top = min_row;
+	left = min_col;
+	bottom = max_row;
+	right = max_col;
 	return true;
 }
 
-int Board::getSize() const
+void Board::setCell(const int& y, const int& x, const char& mark)
 {
-	return board_size;
+	if (!isInside(y, x) || mark == BORDER)
+		throw GridError();
+	place(y, x, mark);
 }
 
-void Board::setCell(const int& y, const int& x, const char& mark)
+void Board::place(const int& y, const int& x, const char& mark)
 {
-	if (y < 0 || y > board_size || x < 0 || x > board_size)
-		throw GridError();
-	grid[index(y, x)] = mark;
+	char old = getCell(y, x);
+	if (old == mark)
+		return;
+
+	if (old != empty)
+		hash ^= cellHash(y, x, old);
+	if (mark != empty)
+		hash ^= cellHash(y, x, mark);
+
+	if (sparse)
+	{
+		if (mark == empty)
+			cells.erase(key(y, x));
+		else
+			cells[key(y, x)] = mark;
+	}
+	else
+		grid[index(y, x)] = mark;
+
+	if (old == empty)
+		addStone(y, x);
+	else if (mark == empty)
+		removeStone(y, x);
 }
 
-const char& Board::getCell(const int& y, const int& x) const
+char Board::getCell(const int& y, const int& x) const
 {
-	if (y < 0 || y > board_size || x < 0 || x > board_size)
-		throw GridError();
-	return grid[index(y, x)];
+	if (!sparse)
+		return grid[index(y, x)];
+	if (!isInside(y, x))
+		return BORDER;
+
+	auto it = cells.find(key(y, x));
+	return it == cells.end() ? empty : it->second;
 }
 
+int Board::countRun(const int& row, const int& col, const int& direction, const int& step, const char& mark) const
+{
+	int count = 0;
+	if (!sparse)
+	{
+		int offset = offsets[direction] * step;
+		for (int i = index(row, col) + offset; grid[i] == mark; i += offset)
+			count++;
+		return count;
+	}
 
+	int dr = DIRECTIONS[direction][0] * step, dc = DIRECTIONS[direction][1] * step;
+	for (int r = row + dr, c = col + dc; getCell(r, c) == mark; r += dr, c += dc)
+		count++;
+	return count;
+}
 
+void Board::countWindow(const int& row, const int& col, const int& direction, const int& length,
+                        const char& first, const char& second, int& firstCount, int& secondCount, int& blocked) const
+{
+	firstCount = secondCount = blocked = 0;
+	if (!sparse)
+	{
+		int offset = offsets[direction];
+		for (int k = 0, i = index(row, col); k < length; k++, i += offset)
+		{
+			char cell = grid[i];
+			firstCount += cell == first;
+			secondCount += cell == second;
+			blocked += cell == BORDER;
+		}
+		return;
+	}
+
+	int dr = DIRECTIONS[direction][0], dc = DIRECTIONS[direction][1];
+	for (int k = 0; k < length; k++)
+	{
+		char cell = getCell(row + k * dr, col + k * dc);
+		firstCount += cell == first;
+		secondCount += cell == second;
+		blocked += cell == BORDER;
+	}
+}
 
 std::vector<std::pair<int, int>> Board::getEmptyCells() const
 {
-	std::vector<std::pair<int, int>> cells;
+	if (isInfinite())
+		return getFrontier();
+
+	std::vector<std::pair<int, int>> result;
 	for (int i = 0; i < board_size; i++)
 		for (int j = 0; j < board_size; j++)
-			if (grid[index(i, j)] == empty)
-				cells.emplace_back(i, j);
-	return cells;
+			if (getCell(i, j) == empty)
+				result.emplace_back(i, j);
+	return result;
+}
+
+std::vector<std::pair<int, int>> Board::getFrontier() const
+{
+	std::vector<std::pair<int, int>> frontier;
+	std::unordered_set<long long> visited;
+
+	if (!sparse)
+	{
+		// Generation stamps avoid clearing an O(size^2) visited array per call.
+		if (seen.size() != grid.size())
+			seen.assign(grid.size(), 0);
+		if (++seen_stamp == 0)
+		{
+			std::fill(seen.begin(), seen.end(), 0);
+			seen_stamp = 1;
+		}
+	}
+
+	for (const auto& stone : stones)
+		for (int di = -1; di <= 1; di++)
+			for (int dj = -1; dj <= 1; dj++)
+			{
+				int ni = stone.first + di;
+				int nj = stone.second + dj;
+				if (getCell(ni, nj) != empty)
+					continue;
+
+				if (sparse)
+				{
+					if (!visited.insert(key(ni, nj)).second)
+						continue;
+				}
+				else
+				{
+					if (seen[index(ni, nj)] == seen_stamp)
+						continue;
+					seen[index(ni, nj)] = seen_stamp;
+				}
+				frontier.emplace_back(ni, nj);
+			}
+
+	return frontier;
 }
 
 bool Board::checkWin(const char& mark, const int& win_length) const
 {
-    const int dirs[4][2] = {
-        {0, 1},   
-        {1, 0},   
-        {1, 1},   
-        {1, -1}  
-    };
-    
-    for (int row = 0; row < board_size; row++) 
+    TraceTimer timer(Tracer::CHECK_WIN);
+    for (const auto& stone : stones)
     {
-        for (int col = 0; col < board_size; col++) 
+        int row = stone.first, col = stone.second;
+        if (getCell(row, col) != mark) continue;
+
+        for (int d = 0; d < 4; d++)
         {
-            if (grid[index(row, col)] != mark) continue;
-            
-            for (int d = 0; d < 4; d++) {
-                int dr = dirs[d][0], dc = dirs[d][1];
-                
-                bool win = true;
-                for (int k = 0; k < win_length; k++) {
-                    int r = row + dr * k;
-                    int c = col + dc * k;
-                    if (r < 0 || r >= board_size || c < 0 || c >= board_size || grid[index(r, c)] != mark) 
-                    {
-                        win = false;
-                        break;
-                    }
-                }
-                if (win) 
-                    return true;
-            }
+            // Count each run once, from its first stone.
+            if (countRun(row, col, d, -1, mark) > 0)
+                continue;
+            if (1 + countRun(row, col, d, 1, mark) >= win_length)
+                return true;
         }
     }
     return false;
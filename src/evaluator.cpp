@@ -0,0 +1,184 @@
+#include "../head/evaluator.h"
+#include "../head/tracer.h"
+#include <algorithm>
+
+Evaluator::Evaluator(const char& ai, const char& player, const int& wlength)
+    : aiMark(ai), playerMark(player), win_length(wlength), patterns(PatternTable::get(wlength)) {}
+
+bool Evaluator::isTerminal(const Board& board) const 
+{
+    return board.checkWin(aiMark, win_length) ||
+           board.checkWin(playerMark, win_length) ||
+           board.isFull();
+}
+
+int Evaluator::evaluate(const Board& board) const
+{
+    TraceTimer timer(Tracer::EVALUATE);
+    if (board.checkWin(aiMark, win_length))
+        return EngineConst::WIN_SCORE;
+    else if (board.checkWin(playerMark, win_length))
+        return EngineConst::LOSS_SCORE;
+   
+    return evaluatePosition(board);
+}
+
+int Evaluator::evaluateLine(const Board& board, std::pair<int, int> start, const int& direction) const 
+{    
+    int aiCount, playerCount, blocked;
+    board.countWindow(start.first, start.second, direction, win_length, aiMark, playerMark, aiCount, playerCount, blocked);
+    if (blocked > 0)
+        return 0;
+    return patterns->score(aiCount, playerCount);
+}
+
+
+int Evaluator::evaluatePosition(const Board& board) const 
+{
+    int score = 0;
+
+    // Windows without stones score zero, so only windows through a stone are
+    // visited, each once: from the first stone it contains. Windows reaching
+    // into the border are skipped.
+    for (const auto& stone : board.getStones())
+        for (int d = 0; d < 4; d++)
+            for (int offset = 0; offset < win_length; offset++)
+            {
+                int startRow = stone.first - offset * Board::DIRECTIONS[d][0];
+                int startCol = stone.second - offset * Board::DIRECTIONS[d][1];
+
+                int aiBefore, playerBefore, blocked;
+                board.countWindow(startRow, startCol, d, offset, aiMark, playerMark, aiBefore, playerBefore, blocked);
+                if (aiBefore > 0 || playerBefore > 0)
+                    continue;
+
+                score += evaluateLine(board, {startRow, startCol}, d);
+            }
+
+    auto [centerRow, centerCol] = board.getCenter();
+    for (int i = centerRow - 1; i <= centerRow + 1; i++)
+        for (int j = centerCol - 1; j <= centerCol + 1; j++)
+            if (board.isInside(i, j)) 
+            {
+                if (board.getCell(i, j) == aiMark)
+                    score += 5;
+                else if (board.getCell(i, j) == playerMark)
+                    score -= 5;
+            }
+    
+    return score;
+}
+
+bool Evaluator::moveGains(const Board& board, const std::vector<std::pair<int, int>>& cells,
+                          std::vector<int>& aiGains, std::vector<int>& playerGains) const
+{
+    int top, left, bottom, right;
+    if (board.isSparse() || !board.getBounds(top, left, bottom, right))
+        return false;
+
+    const char* grid = board.getGrid();
+    int size = board.getGridSize();
+    int stride = board.getStride();
+    int border = board.getBorder();
+    const int* firstGains = patterns->getFirstGains();
+    const int* secondGains = patterns->getSecondGains();
+    int blockedIndex = patterns->blockedIndex();
+
+    // Every window through a frontier cell starts within win_length rows
+    // above the stones (and a few cells more on the diagonal) and ends
+    // within win_length rows below them. Whole mailbox rows are scanned:
+    // windows that wrap around a row end run into the border and are blocked.
+    int lo = std::max(0, (top - win_length - 1 + border) * stride);
+    int hi = std::min(size, (bottom + win_length + 1 + border) * stride);
+
+    aiCounts.resize(size);
+    playerCounts.resize(size);
+    blockedCounts.resize(size);
+    aiDeltas.resize(size);
+    playerDeltas.resize(size);
+    aiSums.assign(size, 0);
+    playerSums.assign(size, 0);
+
+    for (int d = 0; d < 4; d++)
+    {
+        int offset = board.getOffset(d);
+        int end = std::max(lo, std::min(hi, size - (win_length - 1) * offset));
+
+        // Stone counts of the window starting at each index, as plain loops
+        // over the grid bytes so the compiler can vectorise them.
+        std::fill(aiCounts.begin() + lo, aiCounts.begin() + end, 0);
+        std::fill(playerCounts.begin() + lo, playerCounts.begin() + end, 0);
+        std::fill(blockedCounts.begin() + lo, blockedCounts.begin() + end, 0);
+        for (int k = 0; k < win_length; k++)
+        {
+            const char* cell = grid + k * offset;
+            for (int i = lo; i < end; i++)
+            {
+                aiCounts[i] += cell[i] == aiMark;
+                playerCounts[i] += cell[i] == playerMark;
+                blockedCounts[i] += cell[i] == Board::BORDER;
+            }
+        }
+
+        for (int i = lo; i < end; i++)
+        {
+            int pattern = blockedCounts[i] ? blockedIndex : aiCounts[i] * (win_length + 1) + playerCounts[i];
+            aiDeltas[i] = firstGains[pattern];
+            playerDeltas[i] = secondGains[pattern];
+        }
+        std::fill(aiDeltas.begin() + end, aiDeltas.begin() + hi, 0);
+        std::fill(playerDeltas.begin() + end, playerDeltas.begin() + hi, 0);
+
+        // A cell's gain is the sum over the win_length windows through it.
+        for (int k = 0; k < win_length; k++)
+        {
+            int shift = k * offset;
+            for (int i = lo + shift; i < hi; i++)
+            {
+                aiSums[i] += aiDeltas[i - shift];
+                playerSums[i] += playerDeltas[i - shift];
+            }
+        }
+    }
+
+    aiGains.resize(cells.size());
+    playerGains.resize(cells.size());
+    for (size_t i = 0; i < cells.size(); i++)
+    {
+        int index = board.indexOf(cells[i].first, cells[i].second);
+        aiGains[i] = aiSums[index];
+        playerGains[i] = playerSums[index];
+    }
+    return true;
+}
+
+void Evaluator::scoreMoves(Board& board, const std::vector<std::pair<int, int>>& cells,
+                           std::vector<int>& aiScores, std::vector<int>& playerScores) const
+{
+    TraceTimer timer(Tracer::EVALUATE);
+    if (!moveGains(board, cells, aiScores, playerScores))
+    {
+        aiScores.resize(cells.size());
+        playerScores.resize(cells.size());
+        for (size_t i = 0; i < cells.size(); i++)
+        {
+            board.place(cells[i].first, cells[i].second, aiMark);
+            aiScores[i] = evaluate(board);
+            board.place(cells[i].first, cells[i].second, playerMark);
+            playerScores[i] = evaluate(board);
+            board.place(cells[i].first, cells[i].second, board.getEmpty());
+        }
+        return;
+    }
+
+    int base = evaluatePosition(board);
+    auto [centerRow, centerCol] = board.getCenter();
+    for (size_t i = 0; i < cells.size(); i++)
+    {
+        bool center = abs(cells[i].first - centerRow) <= 1 && abs(cells[i].second - centerCol) <= 1;
+        aiScores[i] = aiScores[i] >= PatternTable::WIN_GAIN / 2 ? EngineConst::WIN_SCORE
+                    : base + aiScores[i] + (center ? 5 : 0);
+        playerScores[i] = playerScores[i] <= -PatternTable::WIN_GAIN / 2 ? EngineConst::LOSS_SCORE
+                        : base + playerScores[i] - (center ? 5 : 0);
+    }
+}
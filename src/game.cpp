@@ -1,38 +1,34 @@
 
+
+#include <algorithm>
 #include "../head/game.h"
 
+// Lines printed under the board each turn besides the thinking log: the
+// turn line, the move prompt or announcement, and room for a retry message
+// or the result.
+const int PROMPT_LINES = 4;
+
+// Each AI plays its own mark against the other player's and reads its own
+// section before [AI], so the two sides of an AI-vs-AI game search and
+// evaluate for themselves.
+static Player* makePlayer(const Cfig& config, const std::string& section, const char& mark, const char& opponent)
+{
+	if (config.get<std::string>(section, "type", "human") == "ai")
+		return new AI(mark, opponent, config.get<std::string>(section, "name", "AI"), config, section);
+	return new Human(mark, config.get<std::string>(section, "name", "Player"));
+}
+
 Game::Game(const Cfig& config)
 {
 	win_length = config.get<int>("game", "win_length", 3);
-	board = Board(config.get<int>("board", "size", 3),config.get<char>("board", "empty", ' '));
+	int size = config.get<int>("board", "size", 3);
+	board = Board(size, config.get<char>("board", "empty", ' '),
+		config.get<bool>("board", "sparse", size == Board::INFINITE_SIZE || size > Board::SPARSE_THRESHOLD), win_length);
 
-	if (config.get("player2", "type").toString() == std::string("ai") && config.get("player1", "type").toString() == std::string("human"))
-	{
-		player1 = new Human(config.get<char>("player1", "mark", 'X'), config.get<std::string>("player1", "name", "Player"));
-		player2 = new AI(
-			config.get<char>("player2", "mark", 'O'), 
-			config.get<std::string>("player2", "name", "AI"),
-			config, this
-		);
-	}
-	else if (config.get("player1", "type").toString() == std::string("human") && config.get("player2", "type").toString() == std::string("human"))
-	{
-		player1 = new Human(config.get<char>("player1", "mark", 'X'), config.get<std::string>("player1", "name", "Player1"));
-		player2 = new Human(config.get<char>("player2", "mark", 'O'), config.get<std::string>("player2", "name", "Player2"));
-	}
-    else
-    {
-        player1 = new AI(
-			config.get<char>("player1", "mark", 'O'), 
-			config.get<std::string>("player1", "name", "AI"),
-			config, this
-		);
-        player2 = new AI(
-			config.get<char>("player2", "mark", 'O'), 
-			config.get<std::string>("player2", "name", "AI"),
-			config, this
-		);
-    }
+	char mark1 = config.get<char>("player1", "mark", 'X');
+	char mark2 = config.get<char>("player2", "mark", 'O');
+	player1 = makePlayer(config, "player1", mark1, mark2);
+	player2 = makePlayer(config, "player2", mark2, mark1);
 
     playerMark = player1->getMark();
     aiMark = player2->getMark();
@@ -42,6 +38,21 @@ Game::Game(const Cfig& config)
     if (config.has("debug"))
         clear_console = config.get<bool>("debug", "clear_console", false);
 
+    renderer = Renderer(color, clear_console, player1->getMark(), player2->getMark());
+
+    if (config.has("record"))
+        recorder = GameRecorder(config.get<std::string>("record", "file", "games.ttr"));
+
+    if (config.has("trace"))
+    {
+        std::string format = config.get<std::string>("trace", "format", "chrome");
+        tracer = Tracer(config.get<std::string>("trace", "file", format == "folded" ? "trace.folded" : "trace.json"),
+                        format == "folded" ? Tracer::FOLDED : Tracer::CHROME);
+        for (Player* player : {player1, player2})
+            if (AI* ai = dynamic_cast<AI*>(player))
+                ai->setTracer(&tracer);
+    }
+
 	if (config.get("game", "start").toChar() == player1->getMark())
 		currentPlayer = player1;
 	else
@@ -58,18 +69,15 @@ Game::~Game()
 
 void Game::printBoard()
 {
-    if (clear_console)
-    	system("cls");
-	if (color)
-		board.print(player1->getMark(), player2->getMark());
-    else
-    	board.print();
+    // Under the board: the previous AI's thinking log, the turn line and
+    // the move prompt or announcement.
+    AI* previousAI = nullptr;
+    if (currentPlayer != nullptr)
+        previousAI = dynamic_cast<AI*>((currentPlayer == player1) ? player2 : player1);
+    renderer.draw(board, (previousAI ? previousAI->getThinkingLogLines() : 0) + PROMPT_LINES);
 
     if (currentPlayer != nullptr) 
     {
-        Player* previousPlayer = (currentPlayer == player1) ? player2 : player1;
-        
-        AI* previousAI = dynamic_cast<AI*>(previousPlayer);
         if (previousAI) {
             previousAI->printThinkingLog();
             previousAI->clearLastLog();
@@ -102,13 +110,6 @@ bool Game::checkWin(const char& mark) const
     return board.checkWin(mark, win_length);
 }
 
-bool Game::isTerminal(const Board& board) const 
-{
-    return board.checkWin(aiMark, win_length) ||
-           board.checkWin(playerMark, win_length) ||
-           board.isFull();
-}
-
 bool Game::checkWin() const
 {
     return checkWin(playerMark) || checkWin(aiMark);
@@ -136,6 +137,12 @@ void Game::handleInput()
 
 	if (moveMade)
 	{
+		if (recorder.isOpen())
+		{
+			auto move = currentPlayer->getLastMove();
+			recorder.addMove(move.first, move.second);
+		}
+
 		if (checkWin())
 		{
 			gameOver = true;
@@ -159,102 +166,21 @@ void Game::handleInput()
 
 void Game::run()
 {
+    if (recorder.isOpen())
+    {
+        Player* other = (currentPlayer == player1) ? player2 : player1;
+        recorder.begin(board.getSize(), win_length, currentPlayer->getMark(), other->getMark(), board.getEmpty());
+    }
+
     do
 	{
 		printBoard();
 		handleInput();
  	} while (!isOver());
-}
-
-
-
-int Game::evaluate(const Board& board) const
-{
-    if (board.checkWin(aiMark, win_length))
-        return EngineConst::WIN_SCORE;
-    else if (board.checkWin(playerMark, win_length))
-        return EngineConst::LOSS_SCORE;
-   
-    return evaluatePosition(board);
-}
-
-int Game::evaluateLine(const Board& board, std::pair<int, int> start, std::pair<int, int> delta) const 
-{    
-    int aiCount = 0, playerCount = 0, emptyCount = 0;
-    int size = board.getSize();
-    char emptyCell = board.getEmpty();
-    auto [startRow, startCol] = start;
-    auto [deltaRow, deltaCol] = delta;
-   
-    for (int i = 0; i < win_length; i++) 
-    {
-        int row = startRow + i * deltaRow;
-        int col = startCol + i * deltaCol;
-        char cell = board.getCell(row, col);
-        
-        if (cell == aiMark)
-            aiCount++;
-        else if (cell == playerMark)
-            playerCount++;
-        else if (cell == emptyCell)
-            emptyCount++;
-    }
-    
-    if (aiCount > 0 && playerCount > 0)
-        return 0;
-    
-    if (aiCount > 0 && playerCount == 0) {
-        int baseScore = EngineConst::LINE_SCORES[aiCount];
-
-        if (emptyCount > 0)
-            return baseScore + (emptyCount * 2);
-        return baseScore;
-    }
-    
-    if (playerCount > 0 && aiCount == 0) {
-        int baseScore = EngineConst::LINE_SCORES[playerCount];
-        
-        if (emptyCount > 0)
-            return -baseScore + (emptyCount * 2);
-        return -baseScore;
-    }
-    
-    return 0;
-}
 
+    if (recorder.isOpen())
+        recorder.end();
 
-int Game::evaluatePosition(const Board& board) const 
-{
-    int size = board.getSize();
-    int score = 0;
-   
-    for (int row = 0; row < size; row++)
-        for (int col = 0; col <= size - win_length; col++)
-            score += evaluateLine(board, {row, col}, {0, 1});
-    
-    for (int col = 0; col < size; col++)
-        for (int row = 0; row <= size - win_length; row++)
-            score += evaluateLine(board, {row, col}, {1, 0});
-    
-    for (int row = 0; row <= size - win_length; row++)
-        for (int col = 0; col <= size - win_length; col++)
-            score += evaluateLine(board, {row, col}, {1, 1});
-       
-    for (int row = 0; row <= size - win_length; row++)
-        for (int col = win_length - 1; col < size; col++)
-            score += evaluateLine(board, {row, col}, {1, -1});
-    
-   
-    int center = size / 2;
-    for (int i = center - 1; i <= center + 1; i++)
-        for (int j = center - 1; j <= center + 1; j++)
-            if (i >= 0 && i < size && j >= 0 && j < size) 
-            {
-                if (board.getCell(i, j) == aiMark)
-                    score += 5;
-                else if (board.getCell(i, j) == playerMark)
-                    score -= 5;
-            }
-    
-    return score;
+    if (tracer.isEnabled() && !tracer.save())
+        std::cerr << "Can't write trace\n";
 }
@@ -1,197 +1,469 @@
 #include "../head/minimax.h"
-#include "../head/game.h"
 
-MinimaxAI::MinimaxAI(const Cfig& cfig, Game* gameptr) : game(gameptr)
-{   
-    aiMark = cfig("player2", "mark").toChar();     
-    playerMark = cfig("player1", "mark").toChar(); 
-    max_depth = cfig("AI", "depth").toInt();       
-    time_limit = cfig("AI", "time_limit").toInt(); 
-    win_length = cfig("game", "win_length").toInt();
-    showThinking = cfig.get<bool>("AI", "show_thinking", false);    
+// Per-player keys in the player's own section override [AI].
+template <typename T>
+static T setting(const Cfig& cfig, const std::string& section, const std::string& key, const T& fallback)
+{
+    return cfig.get<T>(section, key, cfig.get<T>("AI", key, fallback));
 }
 
-MinimaxAI::~MinimaxAI()
-{
-    delete game;
+MinimaxAI::MinimaxAI(const Cfig& cfig, const char& ai, const char& opponent, const std::string& section)
+    : MinimaxAI(cfig, ai, opponent, section, cfig.get<int>("game", "win_length", 3)) {}
+
+MinimaxAI::MinimaxAI(const Cfig& cfig, const char& ai, const char& opponent, const std::string& section, const int& wlength)
+    : playerMark(opponent), aiMark(ai), win_length(wlength)
+{   
+    max_depth = setting<int>(cfig, section, "depth", 6);
+    time_limit = setting<int>(cfig, section, "time_limit", 0);
+    node_limit = setting<int>(cfig, section, "node_limit", 0);
+    showThinking = setting<bool>(cfig, section, "show_thinking", false);
+    evaluator = Evaluator(aiMark, playerMark, win_length);
+    setTableSize(setting<int>(cfig, section, "tt_size", 0));
+
+    options.lmr = setting<bool>(cfig, section, "lmr", false);
+    options.null_move = setting<bool>(cfig, section, "null_move", false);
+    options.extensions = setting<bool>(cfig, section, "extensions", false);
+    options.quiescence = setting<bool>(cfig, section, "quiescence", false);
+    options.quiescence_depth = setting<int>(cfig, section, "quiescence_depth", options.quiescence_depth);
+    options.multi_pv = setting<int>(cfig, section, "multi_pv", options.multi_pv);
 }
 
-bool MinimaxAI::timeUp() const 
+MinimaxAI::MinimaxAI(const char& ai, const char& player, const int& wlength, const int& depth, const int& tlimit)
+    : playerMark(player), aiMark(ai), max_depth(depth), time_limit(tlimit), win_length(wlength),
+      showThinking(false), evaluator(ai, player, wlength) {}
+
+bool MinimaxAI::outOfBudget() const 
 {   
-    return (clock() - startTime) * 1000.0 / CLOCKS_PER_SEC > time_limit;
+    if (node_limit > 0 && nodes >= node_limit)
+        return true;
+    if (control)
+    {
+        if (control->stop.load(std::memory_order_relaxed))
+            return true;
+        long long deadline = control->deadline.load(std::memory_order_relaxed);
+        if (deadline > 0)
+            return std::chrono::steady_clock::now().time_since_epoch() >= std::chrono::nanoseconds(deadline);
+    }
+    return time_limit > 0 && std::chrono::steady_clock::now() - startTime > std::chrono::milliseconds(time_limit);
 }
 
 void MinimaxAI::setMove(Board& board, int row, int col, char mark) 
 {
-    board.setCell(row, col, mark);
+    board.place(row, col, mark);
 }
 
 void MinimaxAI::undoMove(Board& board, int row, int col) 
 {
-    board.setCell(row, col, board.getEmpty());
+    board.place(row, col, board.getEmpty());
 }
 
 int MinimaxAI::quickMoveScore(const Board& board, int row, int col, char mark, bool forAI) const 
 {
     int score = 0;
     int size = board.getSize();
-    int center = size / 2;
-    int distance = abs(row - center) + abs(col - center);
+    auto [centerRow, centerCol] = board.getCenter();
+    int distance = abs(row - centerRow) + abs(col - centerCol);
     score += (size - distance) * 3;
 
-    Board tempBoard = board;
-    tempBoard.setCell(row, col, mark);
-    if (tempBoard.checkWin(mark, win_length))
+    if (completesLine(board, row, col, mark))
         score += EngineConst::WIN_SCORE / 10;
 
     char opponentMark = forAI ? playerMark : aiMark;
-    tempBoard.setCell(row, col, opponentMark);
-    if (tempBoard.checkWin(opponentMark, win_length))
+    if (completesLine(board, row, col, opponentMark))
         score += EngineConst::WIN_SCORE / 20;
     
     return score;
 }
 
-std::vector<std::pair<int, int>> MinimaxAI::getOrderedMoves(const Board& board, bool forAI) const 
+std::vector<std::pair<int, int>> MinimaxAI::getCandidateMoves(const Board& board) const 
 {    
-    std::vector<std::pair<int, int>> moves;   
-    int size = board.getSize();
-    std::vector<bool> considered(size * size, false);
-
-    for (int i = 0; i < size; i++) 
-        for (int j = 0; j < size; j++) 
-            if (board.getCell(i, j) != board.getEmpty()) 
-                for (int di = -1; di <= 1; di++) 
-                    for (int dj = -1; dj <= 1; dj++) 
-                    {
-                        int ni = i + di;
-                        int nj = j + dj;
-                        
-                        if (ni >= 0 && ni < size && nj >= 0 && nj < size &&
-                            board.getCell(ni, nj) == board.getEmpty() &&
-                            !considered[ni * size + nj]) 
-                        {
-                            moves.emplace_back(ni, nj);
-                            considered[ni * size + nj] = true;
-                        }
-                    }
+    auto moves = board.getFrontier();
 
     if (moves.empty()) 
     {
-        int center = size / 2;
-        if (board.isCellEmpty(center, center))
-            moves.emplace_back(center, center);
+        auto center = board.getCenter();
+        if (board.isCellEmpty(center.first, center.second))
+            moves.push_back(center);
     }
-    
-    std::sort(moves.begin(), moves.end(),
-        [&](const std::pair<int, int>& a, const std::pair<int, int>& b) 
+
+    return moves;
+}
+
+std::vector<std::pair<int, int>> MinimaxAI::getOrderedMoves(const Board& board, bool forAI) const 
+{    
+    TraceTimer timer(Tracer::ORDERING);
+    auto moves = getCandidateMoves(board);
+
+    // Score each move once; the stable sort keeps ties in frontier order so
+    // the move order, and with it the whole search, is reproducible. Dense
+    // boards get all moves scored by the evaluator's batched kernel: what the
+    // move adds for the side to move (counted twice, so a win goes before a
+    // block) plus what it takes from the opponent.
+    std::vector<int> aiGains, playerGains;
+    bool batched = evaluator.moveGains(board, moves, aiGains, playerGains);
+    std::vector<std::pair<int, std::pair<int, int>>> scored;
+    scored.reserve(moves.size());
+    for (size_t i = 0; i < moves.size(); i++)
+        if (batched)
+            scored.emplace_back(forAI ? 2 * aiGains[i] - playerGains[i] : aiGains[i] - 2 * playerGains[i], moves[i]);
+        else
+            scored.emplace_back(quickMoveScore(board, moves[i].first, moves[i].second, forAI ? aiMark : playerMark, forAI), moves[i]);
+
+    std::stable_sort(scored.begin(), scored.end(),
+        [](const std::pair<int, std::pair<int, int>>& a, const std::pair<int, std::pair<int, int>>& b) 
         {
-            int scoreA = quickMoveScore(board, a.first, a.second, 
-                                       forAI ? aiMark : playerMark, forAI);
-            int scoreB = quickMoveScore(board, b.first, b.second, 
-                                       forAI ? aiMark : playerMark, forAI);
-            return scoreA > scoreB;
+            return a.first > b.first;
         });
-    
+
+    for (size_t i = 0; i < scored.size(); i++)
+        moves[i] = scored[i].second;
     return moves;
 }
 
 int MinimaxAI::minimax(Board& board, int depth, int alpha, int beta,
-                      bool maximizingPlayer) 
+                      bool maximizingPlayer, int ply, bool nullAllowed) 
 {
-    if (timeUp()) 
+    if (trackPV)
+    {
+        if (pvTable.size() < (size_t)ply + 2)
+            pvTable.resize(ply + 2);
+        pvTable[ply].clear();
+    }
+
+    nodes++;
+    if (outOfBudget()) 
         return 0;
     
-    if (depth == 0 || game->isTerminal(board))
-        return game->evaluate(board);
+    if (evaluator.isTerminal(board))
+        return evaluator.evaluate(board);
+
+    if (depth <= 0)
+    {
+        if (options.quiescence)
+            return quiescence(board, alpha, beta, maximizingPlayer, options.quiescence_depth);
+        return evaluator.evaluate(board);
+    }
+
+    // Null-move searches repeat a position with the other side to move, so
+    // the side is part of the key.
+    unsigned long long key = board.getHash() ^ (maximizingPlayer ? SIDE_KEY : 0);
+    std::pair<int, int> hashMove = EngineConst::NO_MOVE;
+    int alphaOrig = alpha, betaOrig = beta;
+    if (table.isEnabled())
+        if (const TableEntry* entry = table.probe(key))
+        {
+            hashMove = entry->move;
+            if (entry->depth >= depth &&
+                (entry->bound == TranspositionTable::EXACT ||
+                 (entry->bound == TranspositionTable::LOWER && entry->score >= beta) ||
+                 (entry->bound == TranspositionTable::UPPER && entry->score <= alpha)))
+                return entry->score;
+        }
+
+    // Static leaves: a depth-1 node scores all its children in one batch.
+    if (depth == 1 && !options.quiescence && !options.extensions && !board.isSparse())
+    {
+        std::pair<int, int> bestMove;
+        int best = searchLeaves(board, alpha, beta, maximizingPlayer, ply, bestMove);
+        storeEntry(key, depth, best, bestMove, alphaOrig, betaOrig);
+        return best;
+    }
    
     auto moves = getOrderedMoves(board, maximizingPlayer);    
-   
-    if (maximizingPlayer) 
+    auto hashed = std::find(moves.begin(), moves.end(), hashMove);
+    if (hashed != moves.end())
+        std::rotate(moves.begin(), hashed, hashed + 1);
+    char mark = maximizingPlayer ? aiMark : playerMark;
+    char opponentMark = maximizingPlayer ? playerMark : aiMark;
+
+    // Null move: let the side to move pass. If a reduced search still can't
+    // get back inside the window, the real moves won't either. Unsafe while
+    // the opponent already has a winning reply or an open three, whose open
+    // four the reduced search may be too shallow to see, so skip it then.
+    if (options.null_move && nullAllowed && depth > EngineConst::NULL_MOVE_REDUCTION &&
+        !hasWinningReply(board, moves, opponentMark) && !hasOpenThree(board, opponentMark))
     {
-        int maxEval = EngineConst::NEG_INF;
-        
-        for (const auto& move : moves) 
+        int reduced = depth - 1 - EngineConst::NULL_MOVE_REDUCTION;
+        if (maximizingPlayer)
         {
-            if (timeUp()) break;
-           
-            setMove(board, move.first, move.second, aiMark);
-           
-            int eval = minimax(board, depth - 1, alpha, beta, false);
-           
-            undoMove(board, move.first, move.second);
-           
-            maxEval = std::max(maxEval, eval);
-           
+            int eval = minimax(board, reduced, beta - 1, beta, false, ply + 1, false);
+            if (eval >= beta)
+                return eval;
+        }
+        else
+        {
+            int eval = minimax(board, reduced, alpha, alpha + 1, true, ply + 1, false);
+            if (eval <= alpha)
+                return eval;
+        }
+    }
+
+    int best = maximizingPlayer ? EngineConst::NEG_INF : EngineConst::INF;
+    std::pair<int, int> bestMove = EngineConst::NO_MOVE;
+
+    for (size_t i = 0; i < moves.size(); i++) 
+    {
+        if (outOfBudget()) break;
+
+        const auto& move = moves[i];
+        setMove(board, move.first, move.second, mark);
+
+        int threat = (options.extensions || options.lmr) && win_length > 3
+            ? threatLevel(board, move.first, move.second, mark)
+            : EngineConst::THREAT_NONE;
+
+        // Fours must be answered at once, so they never cost depth; open threes
+        // are extended only near the root to keep the tree from exploding.
+        int newDepth = depth - 1;
+        if (options.extensions && ply < max_depth &&
+            (threat >= EngineConst::THREAT_FOUR || (threat == EngineConst::THREAT_OPEN_THREE && ply < 2)))
+            newDepth = depth;
+
+        int eval;
+        bool reduce = options.lmr && i >= (size_t)EngineConst::LMR_FULL_MOVES &&
+                      depth >= EngineConst::LMR_MIN_DEPTH && threat == EngineConst::THREAT_NONE;
+
+        if (reduce)
+        {
+            int reduction = i >= (size_t)EngineConst::LMR_FULL_MOVES * 3 ? 2 : 1;
+            // Late, quiet moves get a reduced null-window probe first and are
+            // searched again at full depth only if they look like an improvement.
+            if (maximizingPlayer)
+            {
+                eval = minimax(board, newDepth - reduction, alpha, alpha + 1, false, ply + 1);
+                if (eval > alpha)
+                    eval = minimax(board, newDepth, alpha, beta, false, ply + 1);
+            }
+            else
+            {
+                eval = minimax(board, newDepth - reduction, beta - 1, beta, true, ply + 1);
+                if (eval < beta)
+                    eval = minimax(board, newDepth, alpha, beta, true, ply + 1);
+            }
+        }
+        else
+            eval = minimax(board, newDepth, alpha, beta, !maximizingPlayer, ply + 1);
+
+        undoMove(board, move.first, move.second);
+
+        if (maximizingPlayer ? eval > best : eval < best)
+        {
+            bestMove = move;
+            if (trackPV)
+            {
+                pvTable[ply].assign(1, move);
+                pvTable[ply].insert(pvTable[ply].end(), pvTable[ply + 1].begin(), pvTable[ply + 1].end());
+            }
+        }
+
+        if (maximizingPlayer)
+        {
+            best = std::max(best, eval);
             alpha = std::max(alpha, eval);
-            if (beta <= alpha)
-                break;
         }
-        
-        return maxEval;
-    } 
-    else 
+        else
+        {
+            best = std::min(best, eval);
+            beta = std::min(beta, eval);
+        }
+
+        if (beta <= alpha)
+            break;
+    }
+
+    storeEntry(key, depth, best, bestMove, alphaOrig, betaOrig);
+    return best;
+}
+
+void MinimaxAI::storeEntry(unsigned long long key, int depth, int best, std::pair<int, int> bestMove,
+                           int alphaOrig, int betaOrig)
+{
+    if (table.isEnabled() && bestMove != EngineConst::NO_MOVE && !outOfBudget())
     {
-        int minEval = EngineConst::INF;
-        
-        for (const auto& move : moves) 
+        int bound = best <= alphaOrig ? TranspositionTable::UPPER
+                  : best >= betaOrig ? TranspositionTable::LOWER
+                  : TranspositionTable::EXACT;
+        table.store(key, depth, best, bound, bestMove);
+    }
+}
+
+// Children of a depth-1 node are leaves, so their evaluate() scores come
+// from one Evaluator::scoreMoves call. Searched best first, the node either
+// cuts off on its first child or visits them all without a cutoff; nodes
+// are counted as if the children had been searched that way one by one.
+int MinimaxAI::searchLeaves(Board& board, int alpha, int beta, bool maximizingPlayer, int ply,
+                            std::pair<int, int>& bestMove)
+{
+    auto moves = getCandidateMoves(board);
+    std::vector<int> aiScores, playerScores;
+    evaluator.scoreMoves(board, moves, aiScores, playerScores);
+    const std::vector<int>& scores = maximizingPlayer ? aiScores : playerScores;
+
+    int best = maximizingPlayer ? EngineConst::NEG_INF : EngineConst::INF;
+    bestMove = EngineConst::NO_MOVE;
+    for (size_t i = 0; i < moves.size(); i++)
+        if (maximizingPlayer ? scores[i] > best : scores[i] < best)
+        {
+            best = scores[i];
+            bestMove = moves[i];
+        }
+
+    bool cutoff = maximizingPlayer ? best >= beta : best <= alpha;
+    nodes += cutoff ? 1 : (long long)moves.size();
+    if (trackPV && bestMove != EngineConst::NO_MOVE)
+        pvTable[ply].assign(1, bestMove);
+    return best;
+}
+
+int MinimaxAI::quiescence(Board& board, int alpha, int beta, bool maximizingPlayer, int qdepth)
+{
+    nodes++;
+    qnodes++;
+    if (outOfBudget())
+        return 0;
+
+    if (evaluator.isTerminal(board))
+        return evaluator.evaluate(board);
+
+    char mark = maximizingPlayer ? aiMark : playerMark;
+    char opponentMark = maximizingPlayer ? playerMark : aiMark;
+    auto candidates = getCandidateMoves(board);
+
+    for (const auto& move : candidates)
+        if (completesLine(board, move.first, move.second, mark))
+            return maximizingPlayer ? EngineConst::WIN_SCORE : EngineConst::LOSS_SCORE;
+
+    std::vector<std::pair<int, int>> forcing;
+    for (const auto& move : candidates)
+        if (completesLine(board, move.first, move.second, opponentMark))
+            forcing.push_back(move);
+
+    // Stand pat is only an option when we don't have to answer a four.
+    int best = maximizingPlayer ? EngineConst::NEG_INF : EngineConst::INF;
+    if (forcing.empty())
+    {
+        int standPat = evaluator.evaluate(board);
+        if (qdepth <= 0)
+            return standPat;
+
+        best = standPat;
+        if (maximizingPlayer)
+        {
+            if (standPat >= beta)
+                return standPat;
+            alpha = std::max(alpha, standPat);
+        }
+        else
+        {
+            if (standPat <= alpha)
+                return standPat;
+            beta = std::min(beta, standPat);
+        }
+
+        for (const auto& move : candidates)
+        {
+            board.place(move.first, move.second, mark);
+            if (threatLevel(board, move.first, move.second, mark) >= EngineConst::THREAT_FOUR)
+                forcing.push_back(move);
+            board.place(move.first, move.second, board.getEmpty());
+        }
+    }
+    else if (qdepth <= 0)
+        return evaluator.evaluate(board);
+
+    for (const auto& move : forcing)
+    {
+        if (outOfBudget()) break;
+
+        setMove(board, move.first, move.second, mark);
+        int eval = quiescence(board, alpha, beta, !maximizingPlayer, qdepth - 1);
+        undoMove(board, move.first, move.second);
+
+        if (maximizingPlayer)
+        {
+            best = std::max(best, eval);
+            alpha = std::max(alpha, eval);
+        }
+        else
         {
-            if (timeUp()) break;
-            
-            setMove(board, move.first, move.second, playerMark);
-            int eval = minimax(board, depth - 1, alpha, beta, true);
-            undoMove(board, move.first, move.second);
-            
-            minEval = std::min(minEval, eval);
+            best = std::min(best, eval);
             beta = std::min(beta, eval);
-            
-            if (beta <= alpha)
-                break;
         }
-        
-        return minEval;
+
+        if (beta <= alpha)
+            break;
     }
+
+    return best;
 }
 
-std::pair<int, int> MinimaxAI::iterativeDeepening(Board& board) 
+int MinimaxAI::searchRoot(Board& board, int depth, int count, std::vector<SearchLine>& result)
 {
-    std::pair<int, int> bestMove = {-1, -1};
+    result.clear();
+    auto moves = getOrderedMoves(board, true);
+
+    int beta = EngineConst::INF;
+
+    for (const auto& move : moves) 
+    {
+        if (outOfBudget()) break;
+
+        // A move only has to beat the count-th best line found so far: scores
+        // above that bound are exact, the rest are upper bounds that just
+        // prove the move is out of the top count.
+        int alpha = (int)result.size() >= count ? result[count - 1].score : EngineConst::NEG_INF;
+
+        TraceSpan span("move", move.first, move.second);
+        setMove(board, move.first, move.second, aiMark);
+
+        SearchLine line;
+        line.move = move;
+        line.score = minimax(board, depth - 1, alpha, beta, false, 1);
+
+        undoMove(board, move.first, move.second);
+
+        if ((int)result.size() >= count && line.score <= alpha)
+            continue;
+
+        line.pv.push_back(move);
+        if (trackPV && pvTable.size() > 1)
+            line.pv.insert(line.pv.end(), pvTable[1].begin(), pvTable[1].end());
+
+        auto position = std::upper_bound(result.begin(), result.end(), line.score,
+            [](int score, const SearchLine& other) { return score > other.score; });
+        result.insert(position, line);
+        if ((int)result.size() > count)
+            result.pop_back();
+    }
+
+    return result.empty() ? EngineConst::NEG_INF : result[0].score;
+}
+
+std::pair<int, int> MinimaxAI::iterativeDeepening(Board& board, int count) 
+{
+    reached_depth = 0;
+    depthScores.clear();
+    lines.clear();
+    std::pair<int, int> bestMove = EngineConst::NO_MOVE;
     int bestScore = EngineConst::NEG_INF;
 
     for (int depth = 1; depth <= max_depth; depth++) 
     {
-        if (timeUp()) break;
-        
-        int currentBest = EngineConst::NEG_INF;
-        std::pair<int, int> currentBestMove = {-1, -1};
-       
-        auto moves = getOrderedMoves(board, true);
-        
-        int alpha = EngineConst::NEG_INF;
-        int beta = EngineConst::INF;
+        if (outOfBudget()) break;
         
-        for (const auto& move : moves) 
-        {
-            if (timeUp()) break;
-           
-            setMove(board, move.first, move.second, aiMark);
-           
-            int score = minimax(board, depth - 1, alpha, beta, false);
-           
-            undoMove(board, move.first, move.second);
-           
-            if (score > currentBest) 
-            {
-                currentBest = score;
-                currentBestMove = move;
-            }
-            alpha = std::max(alpha, currentBest);
-        }
+        TraceSpan span("depth", depth);
+        std::vector<SearchLine> currentLines;
+        int currentBest = searchRoot(board, depth, count, currentLines);
        
-        if (currentBestMove.first != -1 && !timeUp()) 
+        if (!currentLines.empty() && !outOfBudget()) 
         {
-            bestMove = currentBestMove;
+            lines = currentLines;
+            bestMove = lines[0].move;
             bestScore = currentBest;
+            reached_depth = depth;
+            depthScores.push_back(currentBest);
+            if (onDepth)
+                onDepth({depth, bestMove, currentBest, nodes});
            
             if (showThinking) 
             {
@@ -210,44 +482,52 @@ std::pair<int, int> MinimaxAI::iterativeDeepening(Board& board)
             }
         }
     }
+
+    if (showThinking && count > 1)
+        for (size_t i = 0; i < lines.size(); i++)
+        {
+            std::string msg = "[AI] #" + std::to_string(i + 1) + " Score " + std::to_string(lines[i].score) + ":";
+            for (const auto& move : lines[i].pv)
+                msg += " (" + std::to_string(move.first) + "," + std::to_string(move.second) + ")";
+            thinkingLog.push_back(msg);
+        }
+
     return bestMove;
 }
 
 std::pair<int, int> MinimaxAI::findBestMove(Board& board) 
 {   
-    startTime = clock();
+    checkBorder(board);
+    Tracer::Scope scope(tracer);
+    TraceSpan span("findBestMove");
+    startTime = std::chrono::steady_clock::now();
     thinkingLog.clear();
+    nodes = 0;
+    qnodes = 0;
+    reached_depth = 0;
+    lines.clear();
    
-    auto emptyCells = board.getEmptyCells();
+    auto emptyCells = getCandidateMoves(board);
     for (const auto& cell : emptyCells) 
-    {
-        board.setCell(cell.first, cell.second, aiMark);
-        if (board.checkWin(aiMark, win_length)) 
+        if (completesLine(board, cell.first, cell.second, aiMark)) 
         {
-            board.setCell(cell.first, cell.second, board.getEmpty());
             if (showThinking)
                 thinkingLog.push_back("[AI] Find wininng move!");
             return cell;
         }
-        board.setCell(cell.first, cell.second, board.getEmpty());
-    }
     
     for (const auto& cell : emptyCells) 
-    {
-        board.setCell(cell.first, cell.second, playerMark);
-        if (board.checkWin(playerMark, win_length)) 
+        if (completesLine(board, cell.first, cell.second, playerMark)) 
         {
-            board.setCell(cell.first, cell.second, board.getEmpty());
             if (showThinking)
                 thinkingLog.push_back("[AI] Block player win!");
             return cell;
         }
-        board.setCell(cell.first, cell.second, board.getEmpty());
-    }
     
-    std::pair<int, int> bestMove = iterativeDeepening(board);
+    trackPV = options.multi_pv > 1;
+    std::pair<int, int> bestMove = iterativeDeepening(board, std::max(1, options.multi_pv));
    
-    if (bestMove.first == -1 && !emptyCells.empty()) 
+    if (bestMove == EngineConst::NO_MOVE && !emptyCells.empty()) 
     {
         int bestScore = -1000000;
         for (const auto& cell : emptyCells) 
@@ -267,9 +547,117 @@ std::pair<int, int> MinimaxAI::findBestMove(Board& board)
     return bestMove;
 }
 
+std::vector<SearchLine> MinimaxAI::findBestMoves(Board& board, int count)
+{
+    checkBorder(board);
+    Tracer::Scope scope(tracer);
+    TraceSpan span("findBestMoves");
+    startTime = std::chrono::steady_clock::now();
+    thinkingLog.clear();
+    nodes = 0;
+    qnodes = 0;
+
+    // No win/block shortcuts here: every line gets a searched score.
+    trackPV = true;
+    iterativeDeepening(board, std::max(1, count));
+    trackPV = false;
+    return lines;
+}
+
+void MinimaxAI::checkBorder(const Board& board) const
+{
+    // Line scans run unchecked up to win_length cells past the edge.
+    if (!board.isSparse() && board.getBorder() < win_length)
+        throw GridError();
+}
+
 bool MinimaxAI::isWinningMove(const Board& board, int row, int col, char mark) const 
 {
-    Board tempBoard = board;
-    tempBoard.setCell(row, col, mark);
-    return tempBoard.checkWin(mark, win_length);
+    return board.isCellEmpty(row, col) && completesLine(board, row, col, mark);
+}
+
+bool MinimaxAI::completesLine(const Board& board, int row, int col, char mark) const
+{
+    for (int d = 0; d < 4; d++)
+        if (1 + board.countRun(row, col, d, -1, mark) + board.countRun(row, col, d, 1, mark) >= win_length)
+            return true;
+    return false;
+}
+
+int MinimaxAI::threatLevel(const Board& board, int row, int col, char mark) const
+{
+    char empty = board.getEmpty();
+    int level = EngineConst::THREAT_NONE;
+
+    for (int d = 0; d < 4; d++)
+    {
+        int dr = Board::DIRECTIONS[d][0], dc = Board::DIRECTIONS[d][1];
+        for (int start = -(win_length - 1); start <= 0; start++)
+        {
+            int own, free, blocked;
+            board.countWindow(row + start * dr, col + start * dc, d, win_length, mark, empty, own, free, blocked);
+            if (blocked > 0 || own + free < win_length)
+                continue;
+            if (own == win_length)
+                return EngineConst::THREAT_WIN;
+            if (own == win_length - 1)
+                level = EngineConst::THREAT_FOUR;
+        }
+
+        if (level == EngineConst::THREAT_NONE)
+        {
+            int before = board.countRun(row, col, d, -1, mark);
+            int after = board.countRun(row, col, d, 1, mark);
+            int open = (board.getCell(row - (before + 1) * dr, col - (before + 1) * dc) == empty)
+                     + (board.getCell(row + (after + 1) * dr, col + (after + 1) * dc) == empty);
+            if (1 + before + after == win_length - 2 && open == 2)
+                level = EngineConst::THREAT_OPEN_THREE;
+        }
+    }
+    return level;
+}
+
+bool MinimaxAI::hasOpenThree(const Board& board, char mark) const
+{
+    if (win_length <= 3)
+        return false;
+    for (const auto& stone : board.getStones())
+        if (board.getCell(stone.first, stone.second) == mark &&
+            threatLevel(board, stone.first, stone.second, mark) >= EngineConst::THREAT_OPEN_THREE)
+            return true;
+    return false;
+}
+
+bool MinimaxAI::hasWinningReply(const Board& board, const std::vector<std::pair<int, int>>& moves, char mark) const
+{
+    for (const auto& move : moves)
+        if (completesLine(board, move.first, move.second, mark))
+            return true;
+    return false;
+}
+
+MoveAnalysis MinimaxAI::analyseMove(Board& board, int row, int col, int depth)
+{
+    checkBorder(board);
+    Tracer::Scope scope(tracer);
+    TraceSpan span("analyseMove");
+    startTime = std::chrono::steady_clock::now();
+    nodes = 0;
+    qnodes = 0;
+
+    MoveAnalysis result;
+    std::vector<SearchLine> best;
+    result.bestScore = searchRoot(board, depth, 1, best);
+    result.best = best.empty() ? EngineConst::NO_MOVE : best[0].move;
+
+    if (result.best == std::make_pair(row, col))
+        result.playedScore = result.bestScore;
+    else
+    {
+        setMove(board, row, col, aiMark);
+        result.playedScore = minimax(board, depth - 1, EngineConst::NEG_INF, EngineConst::INF, false, 1);
+        undoMove(board, row, col);
+    }
+
+    return result;
 }
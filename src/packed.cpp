@@ -0,0 +1,204 @@
+#include "../head/packed.h"
+
+#include <cstring>
+#include <algorithm>
+#include <filesystem>
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+PackedPosition::PackedPosition(const Board& board, const char& first, const char& second)
+{
+    int size = board.getSize();
+    if (board.isSparse() || size > MAX_SIZE)
+        throw GridError();
+
+    for (const auto& stone : board.getStones())
+    {
+        char mark = board.getCell(stone.first, stone.second);
+        if (mark != first && mark != second)
+            throw GridError();
+        set(stone.first * size + stone.second, mark == first ? FIRST : SECOND);
+    }
+}
+
+Board PackedPosition::toBoard(const int& size, const int& wlength, const char& first, const char& second,
+                              const char& empty) const
+{
+    if (size < 1 || size > MAX_SIZE)
+        throw GridError();
+
+    Board board(size, empty, false, wlength);
+    int cells = size * size;
+    for (int w = 0; w * CELLS_PER_WORD < cells; w++)
+    {
+        // Most words of an early or mid-game position are empty.
+        if (words[w] == 0)
+            continue;
+        for (int index = w * CELLS_PER_WORD; index < std::min(cells, (w + 1) * CELLS_PER_WORD); index++)
+            if (int cell = get(index))
+                board.place(index / size, index % size, cell == FIRST ? first : second);
+    }
+    return board;
+}
+
+int PackedPosition::countStones() const
+{
+    int count = 0;
+    for (int w = 0; w < WORDS; w++)
+    {
+        // One bit per occupied cell: either half of its pair is set.
+        uint64_t occupied = (words[w] | (words[w] >> 1)) & 0x5555555555555555ULL;
+        while (occupied)
+        {
+            occupied &= occupied - 1;
+            count++;
+        }
+    }
+    return count;
+}
+
+uint64_t PackedPosition::hash() const
+{
+    uint64_t hash = 0;
+    for (int w = 0; w < WORDS; w++)
+    {
+        hash = (hash ^ words[w]) * 0x9E3779B97F4A7C15ULL;
+        hash ^= hash >> 29;
+    }
+    return hash;
+}
+
+bool PackedPosition::operator==(const PackedPosition& other) const
+{
+    return std::memcmp(words, other.words, sizeof(words)) == 0;
+}
+
+PositionWriter::PositionWriter(const std::string& path, const int& size, const int& wlength, const char& first, const char& second,
+                               const bool& append)
+{
+    if (size < 1 || size > PackedPosition::MAX_SIZE)
+        throw GridError();
+
+    std::memcpy(header.magic, PositionFormat::MAGIC, sizeof(header.magic));
+    header.version = PositionFormat::VERSION;
+    header.size = size;
+    header.win_length = wlength;
+    header.first = first;
+    header.second = second;
+    header.record_size = sizeof(PositionRecord);
+    header.reserved = 0;
+
+    std::ifstream existing;
+    if (append)
+        existing.open(path, std::ios::binary | std::ios::ate);
+    bool resumed = existing.is_open() && existing.tellg() > 0;
+    if (resumed)
+    {
+        PositionFileHeader old;
+        existing.seekg(0);
+        if (!existing.read(reinterpret_cast<char*>(&old), sizeof(old)) || std::memcmp(&old, &header, sizeof(old)) != 0)
+            throw PositionFileError();
+
+        // Drop a record the last writer left half written.
+        long long records = ((long long)existing.seekg(0, std::ios::end).tellg() - sizeof(header)) / sizeof(PositionRecord);
+        existing.close();
+        std::error_code error;
+        std::filesystem::resize_file(path, sizeof(header) + records * sizeof(PositionRecord), error);
+        if (error)
+            throw PositionFileError();
+    }
+
+    out.open(path, std::ios::binary | (resumed ? std::ios::app : std::ios::trunc));
+    if (out && !resumed)
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+}
+
+void PositionWriter::write(const PackedPosition& position, const PositionLabel& label)
+{
+    PositionRecord record;
+    record.position = position;
+    record.label = label;
+    out.write(reinterpret_cast<const char*>(&record), sizeof(record));
+}
+
+// Maps the whole file read-only, or returns nullptr.
+static void* mapFile(const std::string& path, size_t& bytes)
+{
+    void* data = nullptr;
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING,
+                              FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return nullptr;
+    LARGE_INTEGER size;
+    if (GetFileSizeEx(file, &size) && size.QuadPart >= (LONGLONG)sizeof(PositionFileHeader))
+    {
+        bytes = (size_t)size.QuadPart;
+        // The view keeps the mapping alive once both handles are closed.
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping)
+        {
+            data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            CloseHandle(mapping);
+        }
+    }
+    CloseHandle(file);
+#else
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        return nullptr;
+    struct stat info;
+    if (fstat(fd, &info) == 0 && (size_t)info.st_size >= sizeof(PositionFileHeader))
+    {
+        bytes = info.st_size;
+        data = mmap(nullptr, bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED)
+            data = nullptr;
+        else
+            madvise(data, bytes, MADV_SEQUENTIAL);
+    }
+    close(fd);
+#endif
+    return data;
+}
+
+static void unmapFile(void* data, const size_t& bytes)
+{
+#ifdef _WIN32
+    (void)bytes;
+    UnmapViewOfFile(data);
+#else
+    munmap(data, bytes);
+#endif
+}
+
+PositionFile::PositionFile(const std::string& path)
+{
+    data = mapFile(path, bytes);
+    if (!data)
+        throw PositionFileError();
+
+    const PositionFileHeader& header = getHeader();
+    if (std::memcmp(header.magic, PositionFormat::MAGIC, sizeof(header.magic)) != 0 ||
+        header.version != PositionFormat::VERSION || header.record_size != sizeof(PositionRecord) ||
+        header.size < 1 || header.size > PackedPosition::MAX_SIZE)
+    {
+        unmapFile(data, bytes);
+        data = nullptr;
+        throw PositionFileError();
+    }
+    count = (bytes - sizeof(PositionFileHeader)) / sizeof(PositionRecord);
+}
+
+PositionFile::~PositionFile()
+{
+    if (data)
+        unmapFile(data, bytes);
+}
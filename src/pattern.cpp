@@ -0,0 +1,53 @@
+#include "../head/pattern.h"
+#include "../head/engine_const.h"
+
+#include <map>
+#include <mutex>
+#include <algorithm>
+
+PatternTable::PatternTable(const int& wlength)
+    : win_length(wlength), scores((wlength + 1) * (wlength + 1), 0)
+{
+    // LINE_SCORES covers lines up to five. Longer lines are shifted so that
+    // a stone short of a win still scores LINE_SCORES[4] and sparse windows
+    // bottom out at 1 instead of reading past the end of the table.
+    int shift = std::max(0, win_length - 5);
+    std::vector<int> line(win_length + 1, 0);
+    for (int count = 1; count <= win_length; count++)
+        line[count] = std::max(1, EngineConst::LINE_SCORES[std::max(0, count - shift)]);
+
+    for (int first = 0; first <= win_length; first++)
+        for (int second = 0; first + second <= win_length; second++)
+        {
+            int empty = win_length - first - second;
+            int& score = scores[first * (win_length + 1) + second];
+            if (first > 0 && second == 0)
+                score = line[first] + empty * 2;
+            else if (second > 0 && first == 0)
+                score = -line[second] + empty * 2;
+        }
+
+    firstGains.assign(blockedIndex() + 1, 0);
+    secondGains.assign(blockedIndex() + 1, 0);
+    for (int first = 0; first <= win_length; first++)
+        for (int second = 0; first + second < win_length; second++)
+        {
+            int index = first * (win_length + 1) + second;
+            firstGains[index] = first + 1 == win_length && second == 0
+                ? WIN_GAIN : score(first + 1, second) - score(first, second);
+            secondGains[index] = second + 1 == win_length && first == 0
+                ? -WIN_GAIN : score(first, second + 1) - score(first, second);
+        }
+}
+
+std::shared_ptr<const PatternTable> PatternTable::get(const int& wlength)
+{
+    static std::mutex mutex;
+    static std::map<int, std::shared_ptr<const PatternTable>> tables;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto& table = tables[wlength];
+    if (!table)
+        table = std::shared_ptr<const PatternTable>(new PatternTable(wlength));
+    return table;
+}
@@ -14,13 +14,17 @@ bool Human::makeMove(Board& board)
 
 	while (!validInput)
 	{
-		std::cout << name << " (" << mark << "), input row and col (0-" << board.getSize() - 1 << "): ";
+		if (board.isInfinite())
+			std::cout << name << " (" << mark << "), input row and col: ";
+		else
+			std::cout << name << " (" << mark << "), input row and col (0-" << board.getSize() - 1 << "): ";
 		        
         if (std::cin >> row >> col)
         {
             if (board.isCellEmpty(row, col))
             {
                 board.setCell(row, col, mark);
+                lastMove = {row, col};
                 return true;
             }
             else
@@ -37,8 +41,8 @@ bool Human::makeMove(Board& board)
     return false;
 }
 
-AI::AI(const char& c, const std::string& n, const Cfig& cfig, Game* game)
-	: Player(c, n), aiEngine(cfig, game) 
+AI::AI(const char& c, const char& opponent, const std::string& n, const Cfig& cfig, const std::string& section)
+	: Player(c, n), aiEngine(cfig, c, opponent, section) 
 {
     if (cfig.has("debug"))
         sleep_time = cfig.get<int>("debug", "sleep", 0);
@@ -48,7 +52,7 @@ bool AI::makeMove(Board& board) {
         
     auto bestMove = aiEngine.findBestMove(board);
     
-    if (bestMove.first != -1 && bestMove.second != -1) 
+    if (bestMove != EngineConst::NO_MOVE) 
     {
         std::cout << name << " (" << mark << ") moves to (" 
                   << bestMove.first << ", " << bestMove.second << ")\n";
@@ -60,6 +64,7 @@ bool AI::makeMove(Board& board) {
                              std::to_string(bestMove.second) + ")";
         lastThinkingLog.push_back(moveMsg);    
         board.setCell(bestMove.first, bestMove.second, mark);        
+        lastMove = bestMove;
         return true;
     }    
     return false;
@@ -0,0 +1,64 @@
+#include "../head/pool.h"
+
+WorkerPool::WorkerPool(const int& threads, const int& queue_size) : max_queue(queue_size)
+{
+    for (int i = 0; i < threads; i++)
+        workers.emplace_back(&WorkerPool::work, this);
+}
+
+WorkerPool::~WorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    ready.notify_all();
+    for (auto& worker : workers)
+        worker.join();
+}
+
+bool WorkerPool::submit(std::function<void()> task)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (queue.size() >= max_queue)
+            return false;
+        queue.push_back(std::move(task));
+    }
+    ready.notify_one();
+    return true;
+}
+
+void WorkerPool::push(std::function<void()> task)
+{
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        space.wait(lock, [&] { return queue.size() < max_queue; });
+        queue.push_back(std::move(task));
+    }
+    ready.notify_one();
+}
+
+size_t WorkerPool::pending()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return queue.size();
+}
+
+void WorkerPool::work()
+{
+    while (true)
+    {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            ready.wait(lock, [&] { return stopping || !queue.empty(); });
+            if (stopping && queue.empty())
+                return;
+            task = std::move(queue.front());
+            queue.pop_front();
+        }
+        space.notify_one();
+        task();
+    }
+}
@@ -0,0 +1,116 @@
+#include "../head/record.h"
+
+GameRecorder::GameRecorder(const std::string& path)
+    : out(path, std::ios::binary | std::ios::app)
+{
+    std::ifstream existing(path, std::ios::binary | std::ios::ate);
+    resumed = existing && existing.tellg() > 0;
+}
+
+void GameRecorder::writeVarint(uint32_t value)
+{
+    while (value >= 0x80)
+    {
+        out.put(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    out.put(static_cast<char>(value));
+}
+
+void GameRecorder::begin(const int& bsize, const int& wlength, const char& first, const char& second, const char& empty)
+{
+    size = bsize;
+    if (resumed)
+    {
+        writeVarint(0);
+        resumed = false;
+    }
+    out.write(RecordFormat::MAGIC, sizeof(RecordFormat::MAGIC));
+    out.put(static_cast<char>(RecordFormat::VERSION));
+    writeVarint(bsize);
+    writeVarint(wlength);
+    out.put(first);
+    out.put(second);
+    out.put(empty);
+    out.flush();
+}
+
+void GameRecorder::addMove(const int& row, const int& col)
+{
+    if (size == 0)
+    {
+        writeVarint(zigzag(row) + 1);
+        writeVarint(zigzag(col));
+    }
+    else
+        writeVarint(row * size + col + 1);
+    out.flush();
+}
+
+void GameRecorder::end()
+{
+    writeVarint(0);
+    out.flush();
+}
+
+GameRecordReader::GameRecordReader(const std::string& path)
+    : in(path, std::ios::binary) {}
+
+bool GameRecordReader::readVarint(uint32_t& value)
+{
+    value = 0;
+    for (int shift = 0; shift < 35; shift += 7)
+    {
+        int byte = in.get();
+        if (byte == EOF)
+            return false;
+        value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0)
+            return true;
+    }
+    throw RecordError();
+}
+
+bool GameRecordReader::next(GameRecord& record)
+{
+    while (in.peek() == 0)
+        in.get();
+
+    char magic[3];
+    if (!in.read(magic, sizeof(magic)))
+        return false;
+    if (magic[0] != RecordFormat::MAGIC[0] || magic[1] != RecordFormat::MAGIC[1] || magic[2] != RecordFormat::MAGIC[2] ||
+        in.get() != RecordFormat::VERSION)
+        throw RecordError();
+
+    uint32_t size, wlength;
+    if (!readVarint(size) || !readVarint(wlength))
+        throw RecordError();
+
+    char marks[3];
+    if (!in.read(marks, sizeof(marks)))
+        throw RecordError();
+
+    record.size = size;
+    record.win_length = wlength;
+    record.first = marks[0];
+    record.second = marks[1];
+    record.empty = marks[2];
+    record.moves.clear();
+
+    uint32_t cell, col;
+    while (readVarint(cell) && cell != 0)
+    {
+        if (size == 0)
+        {
+            if (!readVarint(col))
+                break;
+            record.moves.emplace_back(unzigzag(cell - 1), unzigzag(col));
+        }
+        else if (cell > size * size)
+            throw RecordError();
+        else
+            record.moves.emplace_back((cell - 1) / size, (cell - 1) % size);
+    }
+    return true;
+}
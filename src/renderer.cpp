@@ -0,0 +1,224 @@
+#include "../head/renderer.h"
+
+#include <iostream>
+#include <algorithm>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#include <io.h>
+#define isatty _isatty
+#define write _write
+#define STDOUT_FILENO 1
+#else
+#include <unistd.h>
+#include <sys/ioctl.h>
+#endif
+
+// Board layout (1-based terminal coordinates): an empty line, the column
+// numbers, the underline, then one line per row. Visible cell (r, c) sits at
+// line HEADER_LINES + r + 1, column label_width + 2 + c * (label_width + 1) + 1.
+const int HEADER_LINES = 3;
+const int VIEW_MARGIN = 2;
+
+static int digits(int value)
+{
+    int n = value < 0 ? 2 : 1;
+    for (value = value < 0 ? -value : value; value >= 10; value /= 10)
+        n++;
+    return n;
+}
+
+Renderer::Renderer(const bool& use_color, const bool& in_place, const char& p1, const char& p2)
+    : player1(p1), player2(p2)
+{
+    tty = isatty(STDOUT_FILENO);
+    color = use_color && tty;
+    redraw = in_place && tty;
+}
+
+void Renderer::appendNumber(int value, int width)
+{
+    char buffer[12];
+    int n = 0;
+    bool negative = value < 0;
+    if (negative)
+        value = -value;
+    do
+    {
+        buffer[n++] = '0' + value % 10;
+        value /= 10;
+    } while (value > 0);
+    if (negative)
+        buffer[n++] = '-';
+
+    for (int i = n; i < width; i++)
+        frame += ' ';
+    while (n > 0)
+        frame += buffer[--n];
+}
+
+void Renderer::appendCell(const char& cell)
+{
+    if (color && cell == player1)
+    {
+        frame += colors::green;
+        frame += cell;
+        frame += colors::reset;
+    }
+    else if (color && cell == player2)
+    {
+        frame += colors::red;
+        frame += cell;
+        frame += colors::reset;
+    }
+    else
+        frame += cell;
+}
+
+void Renderer::moveTo(int line, int column)
+{
+    frame += "\u001b[";
+    appendNumber(line, 0);
+    frame += ';';
+    appendNumber(column, 0);
+    frame += 'H';
+}
+
+bool Renderer::updateView(const Board& board)
+{
+    int newTop = 0, newLeft = 0, newRows = board.getSize(), newCols = board.getSize();
+
+    if (board.isInfinite())
+    {
+        int bottom, right;
+        if (!board.getBounds(newTop, newLeft, bottom, right))
+        {
+            auto center = board.getCenter();
+            newTop = bottom = center.first;
+            newLeft = right = center.second;
+        }
+        newTop -= VIEW_MARGIN;
+        newLeft -= VIEW_MARGIN;
+        newRows = bottom + VIEW_MARGIN - newTop + 1;
+        newCols = right + VIEW_MARGIN - newLeft + 1;
+    }
+
+    bool changed = newTop != top || newLeft != left || newRows != rows || newCols != cols;
+    top = newTop;
+    left = newLeft;
+    rows = newRows;
+    cols = newCols;
+    label_width = std::max({2, digits(top), digits(top + rows - 1), digits(left), digits(left + cols - 1)});
+    return changed;
+}
+
+void Renderer::fullFrame(const Board& board)
+{
+    int rowPrefix = label_width + 2;
+
+    if (redraw)
+        frame += "\u001b[H\u001b[2J";
+
+    frame += '\n';
+    frame.append(rowPrefix - label_width + 1, ' ');
+    for (int j = 0; j < cols; j++)
+    {
+        appendNumber(left + j, label_width);
+        frame += ' ';
+    }
+    frame += '\n';
+    frame.append(rowPrefix - label_width + 1, ' ');
+    frame.append(cols * (label_width + 1), '_');
+    frame += '\n';
+
+    for (int i = 0; i < rows; i++)
+    {
+        appendNumber(top + i, label_width);
+        frame += "| ";
+        for (int j = 0; j < cols; j++)
+        {
+            appendCell(board.getCell(top + i, left + j));
+            frame.append(label_width, ' ');
+        }
+        frame += '\n';
+    }
+    frame += '\n';
+}
+
+void Renderer::diffFrame(const Board& board)
+{
+    int rowPrefix = label_width + 2;
+
+    for (int i = 0; i < rows; i++)
+        for (int j = 0; j < cols; j++)
+        {
+            char cell = board.getCell(top + i, left + j);
+            if (cell != shown[i * cols + j])
+            {
+                moveTo(HEADER_LINES + i + 1, rowPrefix + j * (label_width + 1) + 1);
+                appendCell(cell);
+            }
+        }
+
+    // Park the cursor under the board and wipe whatever was printed there
+    // last turn (prompts, thinking log) so it can be written again.
+    moveTo(HEADER_LINES + rows + 2, 1);
+    frame += "\u001b[J";
+}
+
+void Renderer::flush()
+{
+    std::cout.flush();
+
+    size_t written = 0;
+    while (written < frame.size())
+    {
+        int n = write(STDOUT_FILENO, frame.data() + written, frame.size() - written);
+        if (n <= 0)
+            break;
+        written += n;
+    }
+}
+
+// Rows of the terminal window, 0 if unknown.
+int Renderer::terminalHeight()
+{
+#ifdef _WIN32
+    CONSOLE_SCREEN_BUFFER_INFO info;
+    if (!GetConsoleScreenBufferInfo(GetStdHandle(STD_OUTPUT_HANDLE), &info))
+        return 0;
+    return info.srWindow.Bottom - info.srWindow.Top + 1;
+#else
+    winsize size;
+    if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &size) != 0)
+        return 0;
+    return size.ws_row;
+#endif
+}
+
+void Renderer::draw(const Board& board, const int& below)
+{
+    bool moved = updateView(board);
+
+    if (frame.capacity() < (size_t)(rows + HEADER_LINES + 2) * (label_width + 2 + cols * 16) + 64)
+        frame.reserve((rows + HEADER_LINES + 2) * (label_width + 2 + cols * 16) + 64);
+    frame.clear();
+
+    if (redraw && !moved && anchored && !shown.empty())
+        diffFrame(board);
+    else
+        fullFrame(board);
+
+    flush();
+
+    // The cursor is now on line HEADER_LINES + rows + 2; if the board and
+    // what follows it don't fit, the screen scrolls and the next frame has
+    // to be drawn in full.
+    anchored = redraw && HEADER_LINES + rows + 2 + below <= terminalHeight();
+
+    shown.resize(rows * cols);
+    for (int i = 0; i < rows; i++)
+        for (int j = 0; j < cols; j++)
+            shown[i * cols + j] = board.getCell(top + i, left + j);
+}
@@ -0,0 +1,82 @@
+#include "../head/search.h"
+
+SearchHandle::SearchHandle(const MinimaxAI& ai, const Board& position,
+                           const std::function<void(const SearchUpdate&)>& onDepth)
+    : engine(ai), board(position), callback(onDepth)
+{
+    engine.setTracer(nullptr);
+    engine.setControl(&control);
+    engine.setDepthCallback([this](const SearchUpdate& update) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            latest = update;
+            hasLatest = true;
+        }
+        if (callback)
+            callback(update);
+    });
+
+    worker = std::thread(&SearchHandle::run, this);
+}
+
+SearchHandle::~SearchHandle()
+{
+    stop();
+    if (worker.joinable())
+        worker.join();
+}
+
+void SearchHandle::run()
+{
+    std::pair<int, int> move = EngineConst::NO_MOVE;
+    std::exception_ptr caught;
+    try
+    {
+        move = engine.findBestMove(board);
+    }
+    catch (...)
+    {
+        caught = std::current_exception();
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    result = move;
+    error = caught;
+    done = true;
+    finished.notify_all();
+}
+
+void SearchHandle::stop()
+{
+    control.stop.store(true, std::memory_order_relaxed);
+}
+
+void SearchHandle::setDeadline(const int& milliseconds)
+{
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(milliseconds);
+    long long ns = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline.time_since_epoch()).count();
+    control.deadline.store(ns > 0 ? ns : 1, std::memory_order_relaxed);
+}
+
+bool SearchHandle::isDone() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return done;
+}
+
+bool SearchHandle::getLatest(SearchUpdate& update) const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (hasLatest)
+        update = latest;
+    return hasLatest;
+}
+
+std::pair<int, int> SearchHandle::wait()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    finished.wait(lock, [this] { return done; });
+    if (error)
+        std::rethrow_exception(error);
+    return result;
+}
@@ -0,0 +1,148 @@
+#include "../head/tracer.h"
+
+#include <fstream>
+#include <map>
+#include <algorithm>
+
+const char* const Tracer::COUNTER_NAMES[COUNTERS] = { "getOrderedMoves", "evaluate", "checkWin" };
+
+Tracer::Tracer(const std::string& file, const Format& fmt)
+    : path(file), format(fmt), origin(std::chrono::steady_clock::now()) {}
+
+long long Tracer::now() const
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - origin).count();
+}
+
+void Tracer::begin(const std::string& name)
+{
+    Open span;
+    span.name = name;
+    span.path = open.empty() ? name : open.back().path + ";" + name;
+    span.firstChild = events.size();
+    std::fill(span.self, span.self + COUNTERS, 0);
+    std::fill(span.calls, span.calls + COUNTERS, 0);
+    span.start = now();
+    open.push_back(span);
+}
+
+void Tracer::end()
+{
+    if (open.empty())
+        return;
+
+    long long finish = now();
+    packCounters(open.back(), finish);
+
+    Open& span = open.back();
+    events.push_back({span.name, span.path, span.start, finish - span.start, (int)open.size() - 1, -1});
+    open.pop_back();
+}
+
+void Tracer::startTimer(const int& counter)
+{
+    timers.push_back({counter, now(), 0});
+}
+
+void Tracer::stopTimer()
+{
+    if (timers.empty())
+        return;
+
+    Running timer = timers.back();
+    timers.pop_back();
+    long long elapsed = now() - timer.start;
+
+    if (!open.empty())
+    {
+        open.back().self[timer.counter] += elapsed - timer.children;
+        open.back().calls[timer.counter]++;
+    }
+    if (!timers.empty())
+        timers.back().children += elapsed;
+}
+
+void Tracer::packCounters(const Open& span, long long finish)
+{
+    // Counted time was spent in this span outside its child spans, so it
+    // fits the gaps between them; filling the gaps in order keeps the
+    // emitted events properly nested for the trace viewers.
+    int depth = (int)open.size();
+    std::vector<std::pair<long long, long long>> gaps;
+    long long cursor = span.start;
+    for (size_t i = span.firstChild; i < events.size(); i++)
+        if (events[i].depth == depth)
+        {
+            if (events[i].start > cursor)
+                gaps.emplace_back(cursor, events[i].start);
+            cursor = std::max(cursor, events[i].start + events[i].duration);
+        }
+    if (finish > cursor)
+        gaps.emplace_back(cursor, finish);
+
+    size_t gap = 0;
+    for (int counter = 0; counter < COUNTERS; counter++)
+    {
+        long long remaining = span.self[counter];
+        long long calls = span.calls[counter];
+        while (remaining > 0 && gap < gaps.size())
+        {
+            long long length = std::min(remaining, gaps[gap].second - gaps[gap].first);
+            events.push_back({COUNTER_NAMES[counter], span.path + ";" + COUNTER_NAMES[counter],
+                              gaps[gap].first, length, depth, calls});
+            calls = 0;
+            remaining -= length;
+            gaps[gap].first += length;
+            if (gaps[gap].first >= gaps[gap].second)
+                gap++;
+        }
+    }
+}
+
+bool Tracer::saveChrome(std::ostream& out) const
+{
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    out.setf(std::ios::fixed);
+    out.precision(3);
+    for (size_t i = 0; i < events.size(); i++)
+    {
+        const Event& event = events[i];
+        out << (i ? ",\n" : "\n") << "{\"name\":\"" << event.name << "\",\"cat\":\""
+            << (event.calls < 0 ? "search" : "aggregate") << "\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":"
+            << event.start / 1000.0 << ",\"dur\":" << event.duration / 1000.0;
+        if (event.calls > 0)
+            out << ",\"args\":{\"calls\":" << event.calls << "}";
+        out << "}";
+    }
+    out << "\n]}\n";
+    return (bool)out;
+}
+
+bool Tracer::saveFolded(std::ostream& out) const
+{
+    // Folded stacks weigh each stack by its self time, in microseconds.
+    std::map<std::string, long long> self;
+    for (const auto& event : events)
+    {
+        self[event.path] += event.duration;
+        size_t parent = event.path.rfind(';');
+        if (parent != std::string::npos)
+            self[event.path.substr(0, parent)] -= event.duration;
+    }
+
+    for (const auto& entry : self)
+        if (entry.second >= 1000)
+            out << entry.first << " " << entry.second / 1000 << "\n";
+    return (bool)out;
+}
+
+bool Tracer::save() const
+{
+    if (!isEnabled())
+        return false;
+
+    std::ofstream out(path);
+    if (!out)
+        return false;
+    return format == FOLDED ? saveFolded(out) : saveChrome(out);
+}
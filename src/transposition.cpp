@@ -0,0 +1,41 @@
+#include "../head/transposition.h"
+
+#include <algorithm>
+
+TranspositionTable::TranspositionTable(const size_t& size_mb)
+{
+    size_t count = size_mb * 1024 * 1024 / sizeof(TableEntry);
+    if (count == 0)
+        return;
+
+    size_t slots = 1;
+    while (slots * 2 <= count)
+        slots *= 2;
+    entries.resize(slots);
+    mask = slots - 1;
+}
+
+const TableEntry* TranspositionTable::probe(const unsigned long long& key) const
+{
+    const TableEntry& entry = entries[key & mask];
+    return entry.bound != NONE && entry.key == key ? &entry : nullptr;
+}
+
+void TranspositionTable::store(const unsigned long long& key, const int& depth, const int& score, const int& bound,
+                               const std::pair<int, int>& move)
+{
+    TableEntry& entry = entries[key & mask];
+    if (entry.bound != NONE && entry.key == key && entry.depth > depth)
+        return;
+
+    entry.key = key;
+    entry.depth = (short)depth;
+    entry.score = score;
+    entry.bound = (char)bound;
+    entry.move = move;
+}
+
+void TranspositionTable::clear()
+{
+    std::fill(entries.begin(), entries.end(), TableEntry());
+}
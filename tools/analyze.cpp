@@ -0,0 +1,173 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <mutex>
+#include <thread>
+#include <algorithm>
+#include "../head/record.h"
+#include "../head/minimax.h"
+#include "../head/pool.h"
+#include "cfig.h"
+
+struct SideStats
+{
+    long long moves = 0;
+    long long matches = 0;
+    long long accurate = 0;
+    long long blunders = 0;
+    long long loss = 0;
+};
+
+struct Blunder
+{
+    int game;
+    int ply;
+    char mark;
+    std::pair<int, int> played;
+    std::pair<int, int> best;
+    int loss;
+};
+
+struct AnalysisStats
+{
+    std::mutex mutex;
+    SideStats sides[2];
+    std::vector<Blunder> blunders;
+    long long games = 0;
+};
+
+struct AnalysisSettings
+{
+    int depth;
+    int blunder;
+    int inaccuracy;
+    SearchOptions options;
+};
+
+static void analyseGame(const GameRecord& record, int index, const AnalysisSettings& settings, AnalysisStats& stats)
+{
+    MinimaxAI engines[2] = {
+        MinimaxAI(record.first, record.second, record.win_length, settings.depth, 0),
+        MinimaxAI(record.second, record.first, record.win_length, settings.depth, 0),
+    };
+    engines[0].setOptions(settings.options);
+    engines[1].setOptions(settings.options);
+
+    Board board(record.size, record.empty, record.size == Board::INFINITE_SIZE || record.size > Board::SPARSE_THRESHOLD,
+                record.win_length);
+    SideStats sides[2];
+    std::vector<Blunder> blunders;
+
+    for (size_t ply = 0; ply < record.moves.size(); ply++)
+    {
+        int side = ply % 2;
+        int row = record.moves[ply].first;
+        int col = record.moves[ply].second;
+
+        MoveAnalysis result = engines[side].analyseMove(board, row, col, settings.depth);
+        int loss = std::max(0, result.bestScore - result.playedScore);
+
+        sides[side].moves++;
+        sides[side].loss += loss;
+        if (result.best == std::make_pair(row, col))
+            sides[side].matches++;
+        if (loss <= settings.inaccuracy)
+            sides[side].accurate++;
+        if (loss >= settings.blunder)
+        {
+            sides[side].blunders++;
+            blunders.push_back({index, (int)ply, record.markAt(ply), {row, col}, result.best, loss});
+        }
+
+        board.setCell(row, col, record.markAt(ply));
+    }
+
+    std::lock_guard<std::mutex> lock(stats.mutex);
+    for (int side = 0; side < 2; side++)
+    {
+        stats.sides[side].moves += sides[side].moves;
+        stats.sides[side].matches += sides[side].matches;
+        stats.sides[side].accurate += sides[side].accurate;
+        stats.sides[side].blunders += sides[side].blunders;
+        stats.sides[side].loss += sides[side].loss;
+    }
+    stats.blunders.insert(stats.blunders.end(), blunders.begin(), blunders.end());
+    stats.games++;
+}
+
+static void printSide(const std::string& name, const SideStats& side)
+{
+    double moves = std::max(1LL, side.moves);
+    std::cout << std::left << std::setw(8) << name << std::right
+              << std::setw(8) << side.moves
+              << std::setw(10) << 100.0 * side.accurate / moves << "%"
+              << std::setw(10) << 100.0 * side.matches / moves << "%"
+              << std::setw(12) << side.loss / moves
+              << std::setw(10) << side.blunders << "\n";
+}
+
+int main()
+{
+    Cfig config("config.ini", Cfig::EQUAL, Cfig::HASH);
+
+    std::string path = config.get<std::string>("analyze", "file", config.get<std::string>("record", "file", "games.ttr"));
+    int threads = config.get<int>("analyze", "threads", 0);
+    if (threads <= 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    int top = config.get<int>("analyze", "top", 10);
+
+    AnalysisSettings settings;
+    settings.depth = config.get<int>("analyze", "depth", 3);
+    settings.blunder = config.get<int>("analyze", "blunder", 5000);
+    settings.inaccuracy = config.get<int>("analyze", "inaccuracy", 100);
+    settings.options.quiescence = config.get<bool>("analyze", "quiescence", false);
+
+    GameRecordReader reader(path);
+    if (!reader.isOpen())
+    {
+        std::cerr << "Can't open " << path << std::endl;
+        return 1;
+    }
+
+    AnalysisStats stats;
+    try
+    {
+        WorkerPool pool(threads, threads * 4);
+        GameRecord record;
+        for (int index = 0; reader.next(record); index++)
+            pool.push([record, index, &settings, &stats] {
+                analyseGame(record, index, settings, stats);
+            });
+    }
+    catch (const RecordError&)
+    {
+        std::cerr << "Broken record in " << path << ", analysed what was read before it" << std::endl;
+    }
+
+    std::cout << stats.games << " games, depth " << settings.depth << ", " << threads << " threads\n\n";
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << std::left << std::setw(8) << "side" << std::right << std::setw(8) << "moves"
+              << std::setw(11) << "accuracy" << std::setw(11) << "best move"
+              << std::setw(12) << "avg loss" << std::setw(10) << "blunders" << "\n";
+    printSide("first", stats.sides[0]);
+    printSide("second", stats.sides[1]);
+
+    std::sort(stats.blunders.begin(), stats.blunders.end(), [](const Blunder& a, const Blunder& b) {
+        if (a.loss != b.loss)
+            return a.loss > b.loss;
+        return a.game != b.game ? a.game < b.game : a.ply < b.ply;
+    });
+
+    if (!stats.blunders.empty())
+        std::cout << "\nWorst blunders:\n";
+    for (int i = 0; i < top && i < (int)stats.blunders.size(); i++)
+    {
+        const Blunder& b = stats.blunders[i];
+        std::cout << "  game " << b.game << " move " << b.ply + 1 << " (" << b.mark << "): played ("
+                  << b.played.first << "," << b.played.second << "), best (" << b.best.first << ","
+                  << b.best.second << "), loss " << b.loss << "\n";
+    }
+
+    return 0;
+}
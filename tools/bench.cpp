@@ -0,0 +1,194 @@
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <chrono>
+#include "../head/minimax.h"
+#include "cfig.h"
+
+// Fixed 15x15 positions, moves alternate X, O starting with X; the engine plays O.
+const std::vector<std::string> SUITE = {
+    "7,7",
+    "7,7 6,8 8,8",
+    "7,7 6,8 8,8 6,6 9,9",
+    "7,7 7,8 8,7 6,7 8,8 8,6 9,9",
+    "7,7 8,8 7,8 6,6 7,6 7,9 8,7 9,6 6,8",
+    "5,5 7,7 6,6 8,8 5,7 6,7 4,6 8,6 7,5 8,7 9,7",
+    "7,7 7,6 8,6 6,8 9,5 8,7 6,6 5,7 4,8",
+    "3,3 7,7 4,4 7,8 5,6 8,8 6,6 6,9 4,6",
+};
+
+// FNV-1a over the chosen moves and node counts: equal hashes mean two builds
+// searched identically. Only meaningful without a time limit.
+static unsigned long long mix(unsigned long long hash, long long value)
+{
+    for (int i = 0; i < 8; i++)
+    {
+        hash ^= (value >> (i * 8)) & 0xff;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+struct BenchMode
+{
+    std::string name;
+    SearchOptions options;
+    int tt_size = 0;
+};
+
+static Board loadPosition(const std::string& moves, int size, int win_length)
+{
+    Board board(size, '-', win_length);
+    std::istringstream in(moves);
+    std::string move;
+    char mark = 'X';
+    while (in >> move)
+    {
+        int row, col;
+        char comma;
+        std::istringstream cell(move);
+        cell >> row >> comma >> col;
+        board.setCell(row, col, mark);
+        mark = (mark == 'X') ? 'O' : 'X';
+    }
+    return board;
+}
+
+// Children scored per second: every frontier move of each position played
+// and evaluated one by one, as the search did it, against one
+// Evaluator::scoreMoves batch. Both sides' replies count as children.
+static void benchChildren(int win_length, int size)
+{
+    const int rounds = 200;
+    long long children = 0, mismatches = 0;
+    double singleMs = 0, batchMs = 0;
+    std::vector<int> aiScores, playerScores, aiSingle, playerSingle;
+
+    for (const auto& moves : SUITE)
+    {
+        Board board = loadPosition(moves, size, win_length);
+        Evaluator evaluator('O', 'X', win_length);
+        auto cells = board.getFrontier();
+        aiSingle.resize(cells.size());
+        playerSingle.resize(cells.size());
+
+        auto start = std::chrono::steady_clock::now();
+        for (int round = 0; round < rounds; round++)
+            for (size_t i = 0; i < cells.size(); i++)
+            {
+                board.place(cells[i].first, cells[i].second, 'O');
+                aiSingle[i] = evaluator.evaluate(board);
+                board.place(cells[i].first, cells[i].second, 'X');
+                playerSingle[i] = evaluator.evaluate(board);
+                board.place(cells[i].first, cells[i].second, board.getEmpty());
+            }
+        auto middle = std::chrono::steady_clock::now();
+        for (int round = 0; round < rounds; round++)
+            evaluator.scoreMoves(board, cells, aiScores, playerScores);
+        auto end = std::chrono::steady_clock::now();
+
+        singleMs += std::chrono::duration<double, std::milli>(middle - start).count();
+        batchMs += std::chrono::duration<double, std::milli>(end - middle).count();
+        children += 2LL * rounds * cells.size();
+        for (size_t i = 0; i < cells.size(); i++)
+            mismatches += (aiScores[i] != aiSingle[i]) + (playerScores[i] != playerSingle[i]);
+    }
+
+    std::cout << std::fixed << std::setprecision(0) << "children/s: per move " << children / singleMs * 1000
+              << ", batched " << children / batchMs * 1000 << std::setprecision(1) << " ("
+              << singleMs / batchMs << "x), " << mismatches << " mismatches\n\n";
+}
+
+int main()
+{
+    Cfig config("config.ini", Cfig::EQUAL, Cfig::HASH);
+
+    int depth = config.get<int>("AI", "depth", 8);
+    int time_limit = config.get<int>("AI", "time_limit", 2000);
+    int node_limit = config.get<int>("AI", "node_limit", 0);
+    int win_length = config.get<int>("game", "win_length", 5);
+    int size = 15;
+
+    std::vector<BenchMode> modes(9);
+    modes[0].name = "full-width";
+    modes[1].name = "lmr";
+    modes[1].options.lmr = true;
+    modes[2].name = "null-move";
+    modes[2].options.null_move = true;
+    modes[3].name = "extensions";
+    modes[3].options.extensions = true;
+    modes[4].name = "all";
+    modes[4].options.lmr = modes[4].options.null_move = modes[4].options.extensions = true;
+    modes[5].name = "quiescence";
+    modes[5].options.quiescence = true;
+    modes[6].name = "all+qs";
+    modes[6].options = modes[4].options;
+    modes[6].options.quiescence = true;
+    modes[7].name = "all+qs pv3";
+    modes[7].options = modes[6].options;
+    modes[7].options.multi_pv = 3;
+    modes[8].name = "all+qs tt";
+    modes[8].options = modes[6].options;
+    modes[8].tt_size = 16;
+
+    std::cout << "depth limit " << depth << ", time limit " << (time_limit > 0 ? std::to_string(time_limit) + " ms" : "off")
+              << ", node limit " << (node_limit > 0 ? std::to_string(node_limit) : "off") << ", "
+              << SUITE.size() << " positions\n\n";
+    benchChildren(win_length, size);
+    std::cout << std::left << std::setw(12) << "mode" << std::right
+              << std::setw(10) << "avg depth" << std::setw(14) << "nodes"
+              << std::setw(8) << "qs %" << std::setw(12) << "avg swing" << std::setw(10) << "ms"
+              << std::setw(18) << "hash" << "  depths\n";
+
+    for (const auto& mode : modes)
+    {
+        long long nodes = 0;
+        long long qnodes = 0;
+        int depthSum = 0;
+        long long swingSum = 0;
+        int swingCount = 0;
+        std::string depths;
+        unsigned long long hash = 14695981039346656037ULL;
+        auto start = std::chrono::steady_clock::now();
+
+        for (const auto& moves : SUITE)
+        {
+            Board board = loadPosition(moves, size, win_length);
+            MinimaxAI engine('O', 'X', win_length, depth, time_limit);
+            engine.setNodeLimit(node_limit);
+            engine.setOptions(mode.options);
+            engine.setTableSize(mode.tt_size);
+            auto move = engine.findBestMove(board);
+
+            hash = mix(hash, move.first);
+            hash = mix(hash, move.second);
+            hash = mix(hash, engine.getNodeCount());
+
+            nodes += engine.getNodeCount();
+            qnodes += engine.getQuiescenceNodeCount();
+            depthSum += engine.getReachedDepth();
+            depths += " " + std::to_string(engine.getReachedDepth());
+
+            // Score swing between consecutive iterative-deepening depths.
+            const auto& scores = engine.getDepthScores();
+            for (size_t i = 1; i < scores.size(); i++)
+            {
+                swingSum += std::abs((long long)scores[i] - scores[i - 1]);
+                swingCount++;
+            }
+        }
+
+        long long ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+
+        std::cout << std::left << std::setw(12) << mode.name << std::right << std::fixed << std::setprecision(2)
+                  << std::setw(10) << (double)depthSum / SUITE.size()
+                  << std::setw(14) << nodes << std::setw(8) << (nodes ? 100.0 * qnodes / nodes : 0.0)
+                  << std::setw(12) << (swingCount ? swingSum / swingCount : 0) << std::setw(10) << ms
+                  << std::setw(18) << std::hex << hash << std::dec << " " << depths << "\n";
+    }
+
+    return 0;
+}
@@ -0,0 +1,131 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <memory>
+#include <algorithm>
+#include <unordered_set>
+#include <chrono>
+#include "../head/record.h"
+#include "../head/packed.h"
+#include "../head/evaluator.h"
+#include "cfig.h"
+
+// Turns recorded games into a labelled position file: every position before
+// a move, with the move played, the static evaluation and the game result.
+// Only games with the board size, win length and marks of the first game
+// go in. The output is rewritten from the whole games file on every run, so
+// running it again after more games were recorded doesn't repeat the old ones.
+int main()
+{
+    Cfig config("config.ini", Cfig::EQUAL, Cfig::HASH);
+
+    std::string path = config.get<std::string>("dataset", "games", config.get<std::string>("record", "file", "games.ttr"));
+    std::string output = config.get<std::string>("dataset", "file", "positions.ttp");
+
+    GameRecordReader reader(path);
+    if (!reader.isOpen())
+    {
+        std::cerr << "Can't open " << path << std::endl;
+        return 1;
+    }
+
+    std::unique_ptr<PositionWriter> writer;
+    GameRecord first;
+    long long games = 0, skipped = 0, written = 0;
+    try
+    {
+        GameRecord record;
+        while (reader.next(record))
+        {
+            if (record.size < 1 || record.size > PackedPosition::MAX_SIZE ||
+                (writer && (record.size != first.size || record.win_length != first.win_length ||
+                            record.first != first.first || record.second != first.second)))
+            {
+                skipped++;
+                continue;
+            }
+            if (!writer)
+            {
+                first = record;
+                writer.reset(new PositionWriter(output, record.size, record.win_length, record.first, record.second, false));
+            }
+
+            Evaluator evaluator(record.first, record.second, record.win_length);
+            Board board(record.size, record.empty, false, record.win_length);
+            std::vector<PositionRecord> records(record.moves.size());
+            for (size_t ply = 0; ply < record.moves.size(); ply++)
+            {
+                const auto& move = record.moves[ply];
+                records[ply].position = PackedPosition(board, record.first, record.second);
+                records[ply].label.score = evaluator.evaluate(board);
+                records[ply].label.move = move.first * record.size + move.second;
+                board.setCell(move.first, move.second, record.markAt(ply));
+            }
+
+            int8_t result = board.checkWin(record.first, record.win_length) ? 1
+                          : board.checkWin(record.second, record.win_length) ? -1 : 0;
+            for (auto& position : records)
+            {
+                position.label.result = result;
+                writer->write(position.position, position.label);
+            }
+            written += records.size();
+            games++;
+        }
+    }
+    catch (const RecordError&)
+    {
+        std::cerr << "Broken record in " << path << ", converted what was read before it" << std::endl;
+    }
+    catch (const GridError&)
+    {
+        std::cerr << "Bad move in " << path << std::endl;
+        return 1;
+    }
+    if (!writer)
+    {
+        std::cout << "No games to convert in " << path << " (" << skipped << " skipped)\n";
+        return 0;
+    }
+    if (!writer->isOpen())
+    {
+        std::cerr << "Can't write " << output << std::endl;
+        return 1;
+    }
+    writer.reset();
+
+    // Read the whole file back through the mapping: every record converts
+    // to a Board and packs back to itself.
+    auto start = std::chrono::steady_clock::now();
+    std::unique_ptr<PositionFile> mapped;
+    try
+    {
+        mapped.reset(new PositionFile(output));
+    }
+    catch (const PositionFileError&)
+    {
+        std::cerr << "Can't map " << output << std::endl;
+        return 1;
+    }
+    const PositionFile& positions = *mapped;
+    const PositionFileHeader& header = positions.getHeader();
+    std::unordered_set<PackedPosition> unique;
+    long long broken = 0, stones = 0;
+    for (const PositionRecord& record : positions)
+    {
+        unique.insert(record.position);
+        stones += record.position.countStones();
+        Board board = record.position.toBoard(header.size, header.win_length, header.first, header.second, first.empty);
+        broken += PackedPosition(board, header.first, header.second) != record.position;
+    }
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << games << " games (" << skipped << " skipped), " << written << " positions written\n"
+              << output << ": " << positions.size() << " positions of " << (int)header.size << "x" << (int)header.size
+              << ", " << unique.size() << " unique, " << sizeof(PositionRecord) << " bytes each, "
+              << std::fixed << std::setprecision(1) << (double)stones / std::max<size_t>(1, positions.size())
+              << " stones on average\n"
+              << "read back in " << ms << " ms, " << broken << " positions didn't round-trip\n";
+    return broken == 0 ? 0 : 1;
+}
@@ -0,0 +1,251 @@
+#include "../head/server.h"
+
+#include <sstream>
+#include <iostream>
+#include <cstring>
+#include <algorithm>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+void Connection::send(const std::string& line)
+{
+    std::lock_guard<std::mutex> lock(writeMutex);
+    std::string data = line + "\n";
+    size_t sent = 0;
+    while (sent < data.size())
+    {
+        ssize_t n = ::send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+        if (n <= 0)
+            return;
+        sent += n;
+    }
+}
+
+static int workerCount(const Cfig& config)
+{
+    int workers = config.get<int>("server", "workers", 0);
+    if (workers <= 0)
+        workers = std::max(1u, std::thread::hardware_concurrency());
+    return workers;
+}
+
+EngineServer::EngineServer(const Cfig& config)
+    : socket_path(config.get<std::string>("server", "socket", "/tmp/tic-tac-toe.sock")),
+      max_depth(config.get<int>("AI", "depth", 6)),
+      max_sessions(config.get<int>("server", "max_sessions", 1024)),
+      pool(workerCount(config), config.get<int>("server", "queue_size", 64))
+{
+}
+
+std::shared_ptr<Session> EngineServer::findSession(const int& id)
+{
+    std::lock_guard<std::mutex> lock(sessionsMutex);
+    auto it = sessions.find(id);
+    if (it == sessions.end())
+        return nullptr;
+    return it->second;
+}
+
+void EngineServer::search(std::shared_ptr<Connection> conn, int id, std::shared_ptr<Session> session, Board board,
+                          std::chrono::steady_clock::time_point deadline, int count)
+{
+    std::lock_guard<std::mutex> lock(session->mutex);
+
+    auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+    if (left.count() <= 0)
+    {
+        expired++;
+        conn->send("TIMEOUT " + std::to_string(id));
+        return;
+    }
+
+    session->engine.setTimeLimit(left.count());
+    if (count > 0)
+    {
+        auto lines = session->engine.findBestMoves(board, count);
+        served++;
+        std::string reply = "HINT " + std::to_string(id);
+        for (const auto& line : lines)
+            reply += " " + std::to_string(line.move.first) + " " + std::to_string(line.move.second) + " " +
+                     std::to_string(line.score);
+        conn->send(reply);
+        return;
+    }
+
+    auto move = session->engine.findBestMove(board);
+    served++;
+    conn->send("BEST " + std::to_string(id) + " " + std::to_string(move.first) + " " + std::to_string(move.second));
+}
+
+std::string EngineServer::handleLine(const std::shared_ptr<Connection>& conn, const std::string& line)
+{
+    std::istringstream in(line);
+    std::string cmd;
+    in >> cmd;
+
+    if (cmd == "NEW")
+    {
+        int size, wlength;
+        char ai, player, empty = '-';
+        if (!(in >> size >> wlength >> ai >> player) || size <= 0 || wlength <= 0 || wlength > size ||
+            ai == player || ai == empty || player == empty)
+            return "ERR usage: NEW <size> <win_length> <ai_mark> <player_mark>";
+
+        auto session = std::make_shared<Session>();
+        session->board = Board(size, empty, size > Board::SPARSE_THRESHOLD, wlength);
+        session->engine = MinimaxAI(ai, player, wlength, max_depth, 0);
+        session->aiMark = ai;
+        session->playerMark = player;
+        session->win_length = wlength;
+
+        std::lock_guard<std::mutex> lock(sessionsMutex);
+        if ((int)sessions.size() >= max_sessions)
+            return "ERR too many sessions";
+        int id = next_id++;
+        sessions[id] = session;
+        return "OK " + std::to_string(id);
+    }
+
+    if (cmd == "MOVE")
+    {
+        int id, row, col;
+        char mark;
+        if (!(in >> id >> row >> col >> mark))
+            return "ERR usage: MOVE <id> <row> <col> <mark>";
+        auto session = findSession(id);
+        if (!session)
+            return "ERR unknown session";
+
+        std::lock_guard<std::mutex> lock(session->mutex);
+        if (mark != session->aiMark && mark != session->playerMark)
+            return "ERR unknown mark";
+        if (!session->board.isCellEmpty(row, col))
+            return "ERR cell isn't empty or out of bounds";
+        session->board.setCell(row, col, mark);
+        return "OK";
+    }
+
+    if (cmd == "BEST" || cmd == "HINT")
+    {
+        int id, deadline_ms, count = 0;
+        if (cmd == "HINT" && (!(in >> id >> count >> deadline_ms) || count <= 0 || deadline_ms <= 0))
+            return "ERR usage: HINT <id> <count> <deadline_ms>";
+        if (cmd == "BEST" && (!(in >> id >> deadline_ms) || deadline_ms <= 0))
+            return "ERR usage: BEST <id> <deadline_ms>";
+        auto session = findSession(id);
+        if (!session)
+            return "ERR unknown session";
+
+        Board board;
+        {
+            std::lock_guard<std::mutex> lock(session->mutex);
+            board = session->board;
+        }
+        if (board.checkWin(session->aiMark, session->win_length) ||
+            board.checkWin(session->playerMark, session->win_length) || board.isFull())
+            return "ERR game over";
+
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(deadline_ms);
+        std::shared_ptr<Connection> target = conn;
+        bool queued = pool.submit([this, target, id, session, board, deadline, count] {
+            search(target, id, session, board, deadline, count);
+        });
+        if (!queued)
+        {
+            rejected++;
+            return "BUSY " + std::to_string(id);
+        }
+        return "";
+    }
+
+    if (cmd == "FREE")
+    {
+        int id;
+        if (!(in >> id))
+            return "ERR usage: FREE <id>";
+        std::lock_guard<std::mutex> lock(sessionsMutex);
+        if (sessions.erase(id) == 0)
+            return "ERR unknown session";
+        return "OK";
+    }
+
+    if (cmd == "STATS")
+    {
+        std::lock_guard<std::mutex> lock(sessionsMutex);
+        return "STATS sessions=" + std::to_string(sessions.size()) +
+               " queued=" + std::to_string(pool.pending()) +
+               " served=" + std::to_string(served.load()) +
+               " busy=" + std::to_string(rejected.load()) +
+               " timeout=" + std::to_string(expired.load());
+    }
+
+    return "ERR unknown command";
+}
+
+void EngineServer::serve(std::shared_ptr<Connection> conn)
+{
+    std::string buffer;
+    char chunk[4096];
+
+    while (true)
+    {
+        ssize_t n = ::read(conn->fd, chunk, sizeof(chunk));
+        if (n <= 0)
+            break;
+        buffer.append(chunk, n);
+
+        size_t pos;
+        while ((pos = buffer.find('\n')) != std::string::npos)
+        {
+            std::string line = buffer.substr(0, pos);
+            buffer.erase(0, pos + 1);
+            if (!line.empty() && line.back() == '\r')
+                line.pop_back();
+            if (line.empty())
+                continue;
+
+            std::string reply = handleLine(conn, line);
+            if (!reply.empty())
+                conn->send(reply);
+        }
+    }
+
+    // Searches still queued for this connection hold their own reference,
+    // so the descriptor is closed only after the last of them has answered.
+    ::shutdown(conn->fd, SHUT_RD);
+}
+
+void EngineServer::run()
+{
+    int listener = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listener < 0)
+        throw ServerError();
+
+    sockaddr_un addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    std::strncpy(addr.sun_path, socket_path.c_str(), sizeof(addr.sun_path) - 1);
+    ::unlink(socket_path.c_str());
+
+    if (::bind(listener, (sockaddr*)&addr, sizeof(addr)) < 0 || ::listen(listener, 128) < 0)
+    {
+        ::close(listener);
+        throw ServerError();
+    }
+
+    std::cout << "Engine server listening on " << socket_path << std::endl;
+
+    while (true)
+    {
+        int fd = ::accept(listener, nullptr, nullptr);
+        if (fd < 0)
+            continue;
+
+        auto conn = std::shared_ptr<Connection>(new Connection(fd), [](Connection* c) {
+            ::close(c->fd);
+            delete c;
+        });
+        std::thread(&EngineServer::serve, this, conn).detach();
+    }
+}
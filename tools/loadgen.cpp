@@ -0,0 +1,192 @@
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <cstring>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "../head/board.h"
+#include "cfig.h"
+
+struct LoadStats
+{
+    std::vector<double> latencies;
+    long long busy = 0;
+    long long timeouts = 0;
+    long long errors = 0;
+};
+
+class Client
+{
+private:
+    int fd = -1;
+    std::string buffer;
+
+public:
+    bool open(const std::string& path)
+    {
+        fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        sockaddr_un addr;
+        std::memset(&addr, 0, sizeof(addr));
+        addr.sun_family = AF_UNIX;
+        std::strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+        return fd >= 0 && ::connect(fd, (sockaddr*)&addr, sizeof(addr)) == 0;
+    }
+
+    ~Client()
+    {
+        if (fd >= 0)
+            ::close(fd);
+    }
+
+    void send(const std::string& line)
+    {
+        std::string data = line + "\n";
+        ::send(fd, data.data(), data.size(), MSG_NOSIGNAL);
+    }
+
+    std::string receive()
+    {
+        size_t pos;
+        while ((pos = buffer.find('\n')) == std::string::npos)
+        {
+            char chunk[1024];
+            ssize_t n = ::read(fd, chunk, sizeof(chunk));
+            if (n <= 0)
+                return "";
+            buffer.append(chunk, n);
+        }
+        std::string line = buffer.substr(0, pos);
+        buffer.erase(0, pos + 1);
+        return line;
+    }
+
+    std::string request(const std::string& line)
+    {
+        send(line);
+        return receive();
+    }
+};
+
+static void runClient(const std::string& path, int requests, int deadline_ms, int size, int win_length,
+                      unsigned seed, LoadStats& stats)
+{
+    Client client;
+    if (!client.open(path))
+    {
+        stats.errors += requests;
+        return;
+    }
+
+    std::mt19937 rng(seed);
+    int id = -1;
+    Board board;
+
+    for (int i = 0; i < requests; i++)
+    {
+        if (id == -1 || board.getEmptyCells().size() < 2 ||
+            board.checkWin('X', win_length) || board.checkWin('O', win_length))
+        {
+            if (id != -1)
+                client.request("FREE " + std::to_string(id));
+            std::istringstream reply(client.request("NEW " + std::to_string(size) + " " +
+                                                    std::to_string(win_length) + " O X"));
+            std::string ok;
+            if (!(reply >> ok >> id) || ok != "OK")
+            {
+                stats.errors++;
+                return;
+            }
+            board = Board(size, '-', win_length);
+        }
+
+        auto cells = board.getEmptyCells();
+        auto cell = cells[rng() % cells.size()];
+        client.request("MOVE " + std::to_string(id) + " " + std::to_string(cell.first) + " " +
+                       std::to_string(cell.second) + " X");
+        board.setCell(cell.first, cell.second, 'X');
+
+        auto start = std::chrono::steady_clock::now();
+        std::istringstream reply(client.request("BEST " + std::to_string(id) + " " + std::to_string(deadline_ms)));
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        std::string kind;
+        int rid, row, col;
+        reply >> kind;
+        if (kind == "BEST" && reply >> rid >> row >> col && row >= 0)
+        {
+            stats.latencies.push_back(ms);
+            client.request("MOVE " + std::to_string(id) + " " + std::to_string(row) + " " +
+                           std::to_string(col) + " O");
+            board.setCell(row, col, 'O');
+        }
+        else if (kind == "BUSY")
+            stats.busy++;
+        else if (kind == "TIMEOUT")
+            stats.timeouts++;
+        else
+            stats.errors++;
+    }
+
+    if (id != -1)
+        client.request("FREE " + std::to_string(id));
+}
+
+int main()
+{
+    Cfig config("config.ini", Cfig::EQUAL, Cfig::HASH);
+
+    std::string path = config.get<std::string>("server", "socket", "/tmp/tic-tac-toe.sock");
+    int connections = config.get<int>("loadgen", "connections", 16);
+    int requests = config.get<int>("loadgen", "requests", 50);
+    int deadline_ms = config.get<int>("loadgen", "deadline", 100);
+    int size = config.get<int>("loadgen", "size", 15);
+    int win_length = config.get<int>("loadgen", "win_length", 5);
+
+    std::vector<LoadStats> stats(connections);
+    std::vector<std::thread> clients;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < connections; i++)
+        clients.emplace_back(runClient, path, requests, deadline_ms, size, win_length, 1000u + i, std::ref(stats[i]));
+    for (auto& client : clients)
+        client.join();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    LoadStats total;
+    for (const auto& s : stats)
+    {
+        total.latencies.insert(total.latencies.end(), s.latencies.begin(), s.latencies.end());
+        total.busy += s.busy;
+        total.timeouts += s.timeouts;
+        total.errors += s.errors;
+    }
+    std::sort(total.latencies.begin(), total.latencies.end());
+
+    auto percentile = [&](double p) {
+        if (total.latencies.empty())
+            return 0.0;
+        size_t i = std::min(total.latencies.size() - 1, (size_t)(p * total.latencies.size()));
+        return total.latencies[i];
+    };
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "connections: " << connections << ", deadline: " << deadline_ms << " ms\n";
+    std::cout << "served:      " << total.latencies.size() << "\n";
+    std::cout << "busy:        " << total.busy << "\n";
+    std::cout << "timeout:     " << total.timeouts << "\n";
+    std::cout << "errors:      " << total.errors << "\n";
+    std::cout << "throughput:  " << total.latencies.size() / seconds << " moves/s\n";
+    std::cout << "latency p50: " << percentile(0.50) << " ms\n";
+    std::cout << "latency p99: " << percentile(0.99) << " ms\n";
+    std::cout << "latency max: " << (total.latencies.empty() ? 0.0 : total.latencies.back()) << " ms\n";
+
+    return 0;
+}
@@ -0,0 +1,21 @@
+#include <iostream>
+#include "../head/server.h"
+#include "cfig.h"
+
+int main()
+{
+	Cfig config("config.ini", Cfig::EQUAL, Cfig::HASH);
+
+	try
+	{
+		EngineServer server(config);
+		server.run();
+	}
+	catch (const ServerError&)
+	{
+		std::cerr << "Can't open server socket" << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,276 @@
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <set>
+#include <chrono>
+#include <algorithm>
+#include "../head/minimax.h"
+#include "cfig.h"
+
+struct Position
+{
+    std::string name;
+    int size;
+    int win_length;
+    std::string category;
+    std::set<std::pair<int, int>> solutions;
+    std::vector<std::pair<int, int>> moves;
+};
+
+struct Result
+{
+    bool solved = false;
+    long long nodes = 0;
+    double ms = 0;
+};
+
+struct CategoryStats
+{
+    int total = 0;
+    int solved = 0;
+    long long nodes = 0;
+    double ms = 0;
+};
+
+static bool parseCell(const std::string& text, std::pair<int, int>& cell)
+{
+    char comma;
+    std::istringstream in(text);
+    return (bool)(in >> cell.first >> comma >> cell.second) && comma == ',';
+}
+
+static bool parsePosition(const std::string& line, Position& position)
+{
+    std::vector<std::string> parts;
+    std::istringstream in(line);
+    std::string part;
+    while (std::getline(in, part, '|'))
+        parts.push_back(part);
+    if (parts.size() != 3)
+        return false;
+
+    std::istringstream head(parts[0]);
+    if (!(head >> position.name >> position.size >> position.win_length >> position.category))
+        return false;
+
+    std::string token;
+    std::pair<int, int> cell;
+    std::istringstream solutions(parts[1]);
+    while (solutions >> token)
+    {
+        if (!parseCell(token, cell))
+            return false;
+        position.solutions.insert(cell);
+    }
+    std::istringstream moves(parts[2]);
+    while (moves >> token)
+    {
+        if (!parseCell(token, cell))
+            return false;
+        position.moves.push_back(cell);
+    }
+    return !position.solutions.empty();
+}
+
+// Time and nodes to solution: taken at the first depth from which the
+// engine's best move stays a solution. The engine runs with [AI] overridden
+// by [suite] and always searches: findBestMoves has no win/block shortcut,
+// so one-move positions cost real nodes too.
+static Result runPosition(const Position& position, const Cfig& config)
+{
+    Board board(position.size, '-', false, position.win_length);
+    char mark = 'X';
+    for (const auto& move : position.moves)
+    {
+        board.setCell(move.first, move.second, mark);
+        mark = (mark == 'X') ? 'O' : 'X';
+    }
+    char other = (mark == 'X') ? 'O' : 'X';
+
+    MinimaxAI engine(config, mark, other, "suite", position.win_length);
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<Result> updates;
+    engine.setDepthCallback([&](const SearchUpdate& update) {
+        Result result;
+        result.solved = position.solutions.count(update.move) > 0;
+        result.nodes = update.nodes;
+        result.ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        updates.push_back(result);
+    });
+
+    auto lines = engine.findBestMoves(board, std::max(1, engine.getOptions().multi_pv));
+
+    Result result;
+    result.solved = !lines.empty() && position.solutions.count(lines.front().move) > 0;
+    result.nodes = engine.getNodeCount();
+    result.ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    if (result.solved)
+        for (size_t i = updates.size(); i-- > 0 && updates[i].solved;)
+        {
+            result.nodes = updates[i].nodes;
+            result.ms = updates[i].ms;
+        }
+    return result;
+}
+
+// History is a CSV of run,name,solved,nodes,ms rows; each run is compared
+// with the one before it and then appended.
+static int readHistory(const std::string& path, std::map<std::string, Result>& previous)
+{
+    std::ifstream in(path);
+    std::string line;
+    int last = 0;
+    std::vector<std::pair<int, std::pair<std::string, Result>>> rows;
+    while (std::getline(in, line))
+    {
+        std::istringstream row(line);
+        std::string run, name, solved, nodes, ms;
+        if (!std::getline(row, run, ',') || !std::getline(row, name, ',') || !std::getline(row, solved, ',') ||
+            !std::getline(row, nodes, ',') || !std::getline(row, ms, ','))
+            continue;
+        try
+        {
+            Result result;
+            result.solved = solved == "1";
+            result.nodes = std::stoll(nodes);
+            result.ms = std::stod(ms);
+            rows.push_back({std::stoi(run), {name, result}});
+            last = std::max(last, rows.back().first);
+        }
+        catch (const std::exception&)
+        {
+            continue;
+        }
+    }
+    for (const auto& row : rows)
+        if (row.first == last)
+            previous[row.second.first] = row.second.second;
+    return last;
+}
+
+int main()
+{
+    Cfig config("config.ini", Cfig::EQUAL, Cfig::HASH);
+
+    std::string path = config.get<std::string>("suite", "file", "suite/tactics.txt");
+    std::string historyPath = config.get<std::string>("suite", "history", "suite_history.csv");
+    bool verbose = config.get<bool>("suite", "verbose", false);
+
+    std::ifstream in(path);
+    if (!in)
+    {
+        std::cerr << "Can't open " << path << std::endl;
+        return 1;
+    }
+
+    std::vector<Position> positions;
+    std::string line;
+    for (int number = 1; std::getline(in, line); number++)
+    {
+        if (line.empty() || line[0] == '#')
+            continue;
+        Position position;
+        if (!parsePosition(line, position))
+        {
+            std::cerr << path << ":" << number << ": can't parse position" << std::endl;
+            return 1;
+        }
+        positions.push_back(position);
+    }
+
+    std::map<std::string, Result> previous;
+    int run = readHistory(historyPath, previous) + 1;
+
+    std::map<std::string, CategoryStats> categories;
+    std::map<std::string, Result> results;
+    std::cout << std::fixed << std::setprecision(1);
+
+    for (const auto& position : positions)
+    {
+        Result result = runPosition(position, config);
+        results[position.name] = result;
+
+        CategoryStats& stats = categories[position.category];
+        stats.total++;
+        if (result.solved)
+        {
+            stats.solved++;
+            stats.nodes += result.nodes;
+            stats.ms += result.ms;
+        }
+
+        if (verbose || !result.solved)
+            std::cout << std::left << std::setw(18) << position.name << std::right
+                      << (result.solved ? "  ok    " : "  FAIL  ") << std::setw(12) << result.nodes
+                      << " nodes" << std::setw(10) << result.ms << " ms\n";
+    }
+
+    std::cout << "\n" << std::left << std::setw(10) << "category" << std::right << std::setw(10) << "solved"
+              << std::setw(14) << "avg nodes" << std::setw(10) << "avg ms" << "\n";
+    CategoryStats total;
+    for (const auto& entry : categories)
+    {
+        const CategoryStats& stats = entry.second;
+        int solved = std::max(1, stats.solved);
+        std::cout << std::left << std::setw(10) << entry.first << std::right
+                  << std::setw(6) << stats.solved << "/" << std::setw(3) << stats.total
+                  << std::setw(14) << stats.nodes / solved << std::setw(10) << stats.ms / solved << "\n";
+        total.total += stats.total;
+        total.solved += stats.solved;
+        total.nodes += stats.nodes;
+        total.ms += stats.ms;
+    }
+    std::cout << std::left << std::setw(10) << "all" << std::right << std::setw(6) << total.solved << "/"
+              << std::setw(3) << total.total << std::setw(14) << total.nodes / std::max(1, total.solved)
+              << std::setw(10) << total.ms / std::max(1, total.solved) << "\n";
+
+    if (!previous.empty())
+    {
+        // Nodes and time are compared over positions both runs solved.
+        int gained = 0, lost = 0, before = 0;
+        long long nodesBefore = 0, nodesNow = 0;
+        double msBefore = 0, msNow = 0;
+        for (const auto& entry : results)
+        {
+            auto old = previous.find(entry.first);
+            if (old == previous.end())
+                continue;
+            before += old->second.solved;
+            if (entry.second.solved && !old->second.solved)
+            {
+                gained++;
+                std::cout << "  now solved: " << entry.first << "\n";
+            }
+            if (!entry.second.solved && old->second.solved)
+            {
+                lost++;
+                std::cout << "  regressed:  " << entry.first << "\n";
+            }
+            if (entry.second.solved && old->second.solved)
+            {
+                nodesBefore += old->second.nodes;
+                nodesNow += entry.second.nodes;
+                msBefore += old->second.ms;
+                msNow += entry.second.ms;
+            }
+        }
+        std::cout << "\nvs run " << run - 1 << ": solved " << before << " -> " << total.solved
+                  << " (+" << gained << " -" << lost << "), nodes to solution " << nodesBefore << " -> " << nodesNow
+                  << ", ms " << msBefore << " -> " << msNow << "\n";
+    }
+
+    std::ofstream history(historyPath, std::ios::app);
+    history << std::fixed << std::setprecision(3);
+    for (const auto& entry : results)
+        history << run << "," << entry.first << "," << entry.second.solved << "," << entry.second.nodes << ","
+                << entry.second.ms << "\n";
+    if (!history)
+        std::cerr << "Can't write " << historyPath << std::endl;
+
+    return 0;
+}